@@ -18,6 +18,10 @@
 #include <mtObject.h>
 #include <mtScope.h>
 #include <mtHashmap.h>
+#include <mtPool.h>
+#include <mtArena.h>
+#include <mtGC.h>
 #include <mtNumberObject.h>
+#include <mtOutput.h>
 
 #endif // Mint_h
\ No newline at end of file
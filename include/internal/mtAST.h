@@ -7,12 +7,15 @@
 
 #define mtASTInitialChildCapacity 2
 
+struct mtFunction;
+
 enum NodeType {
     NodeType_None,
 
     NodeType_Assignment,
     NodeType_BinaryOperator,
     NodeType_Number,
+    NodeType_Constant, // a value worked out before the program ran, see mtPartialEval.h
     NodeType_Identifier,
     NodeType_Block,
     
@@ -25,23 +28,77 @@ enum NodeType {
     NodeType_IsNotEqual,
 
     NodeType_IfStatement,
+    NodeType_WhileLoop,
+    NodeType_ForLoop,
     NodeType_FunctionDefinition,
     NodeType_FunctionCall,
     NodeType_ParameterList, // not an actual list
     NodeType_ArgumentList,
+    NodeType_InlinedParameter, // a parameter in a body that was inlined, see mtInline.h
+
+};
 
+// what kind of number a node can evaluate to, see mtInfer.h
+enum mtInferredType {
+    Inferred_None, // nothing known reaches it, it doesn't evaluate to a number or never runs
+    Inferred_Integer,
+    Inferred_Decimal,
+    Inferred_Mixed // could be either, ex: a quotient
 };
 
 // abstract syntax tree
 struct ASTNode {
     struct Token token;
 
+    // of the token's text, so identifiers are looked up without hashing them again, see mtHashMapHash
+    uint32_t hash;
+
     enum NodeType type;
 
+    // the value of a NodeType_Constant, and of a NodeType_Number once it has run.
+    struct mtNumber constant;
+
+    // the object literals evaluate to, its payload is constant. Its type is NULL until
+    // it first runs, see interpretLiterals in mtExpression.c
+    struct mtObject literal;
+
     //pointer to multiple pointers
     struct ASTNode** children;
     size_t childCount;
     size_t childCapacity;
+
+    // identifiers in a function's body which name one of its parameters 
+    // get the parameter's index here, it's -1 for everything else.
+    int parameterIndex;
+
+    // function calls remember what they called last time, 
+    // which is still valid as long as mtScopeGetFunctionEpoch() == cachedEpoch
+    struct mtFunction* cachedFunction;
+    size_t cachedEpoch;
+    bool isTailCall;
+
+    enum mtInferredType inferred;
+
+    // operators which are known to get two ints or two decimals skip checking 
+    // the operands, see mtInfer.h and markOperands in mtFunction.c
+    enum {
+        Operands_Unknown,
+        Operands_Integer,
+        Operands_Decimal
+    } operands;
+
+    // function definitions are compiled the first time they run, see interpretFunctionDef
+    struct mtFunction* prototype;
+
+    // binary operators which compute the same as an earlier one in their statement 
+    // return its lastResult instead, which it only keeps if keepsResult, see mtOptimize.h
+    struct ASTNode* sameAs;
+    struct mtObject* lastResult;
+    bool keepsResult;
+
+    // calls with a copy of their function's body as the 3rd child point to the 
+    // definition it was copied from, see mtInline.h
+    struct ASTNode* inlined;
 };
 
 
@@ -7,7 +7,7 @@
 
 
 /*
-*   block       = statments | expressions | function_def | if
+*   block       = statments | expressions | function_def | if | while | for
 *   statement   = identifier {assign} expression 
 *   expression  = {add | sub} term {add | sub} term 
 *   term        = factor  {mul | div} factor  
@@ -17,6 +17,8 @@
 *   function_call   = identifier "lparen" [arguments] "rparen"
 *   
 *   if  = "if" {conditional} block "end"
+*   while   = "while" {conditional} block "end"
+*   for     = "for" identifier "assign" expression "comma" expression block "end"
 *
 *   params      = ("comma", identifier) // () = list, comma separates the identifiers
 *   arguments   = ("comma", expression) // "comma" separates the expressions 
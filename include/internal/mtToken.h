@@ -29,10 +29,13 @@ enum TokenType {
     TokenType_LeftBracket,
     TokenType_RightBracket,
     TokenType_Comma,
+    TokenType_Colon,
 
     TokenType_FunctionKeyword,
     TokenType_EndKeyword,
-    TokenType_IfKeyword
+    TokenType_IfKeyword,
+    TokenType_WhileKeyword,
+    TokenType_ForKeyword
 };
 
 struct Token {
@@ -29,6 +29,7 @@ struct TokenTypeRules
     const char divisionChar;
     const char multiplicationChar;
     const char commaChar;
+    const char colonChar; // separates a parameter from its type hint, ex: x: int
 
     const char exclamationChar;
 
@@ -44,6 +45,8 @@ struct TokenTypeRules
     const char* functionKeyword;
     const char* endKeyword;
     const char* ifKeyword;
+    const char* whileKeyword;
+    const char* forKeyword;
 };
 
 struct TokenizerState 
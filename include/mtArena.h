@@ -0,0 +1,59 @@
+
+#ifndef mtArena_h
+#define mtArena_h
+
+/*
+*   A region allocator, memory is handed out by bumping a pointer and it's
+*   all given back at once by resetting the arena to an earlier mark.
+*
+*   Marks nest, so a mark taken while an outer one is live can be reset to
+*   without touching anything allocated before it. The blocks are kept
+*   around after a reset and reused by the next allocations.
+*/
+
+#include <stdlib.h> // for size_t
+
+// the default size of a block, bigger allocations get a block of their own.
+#define mtArenaBlockSize    (64 * 1024)
+#define mtArenaAlignment    16
+
+struct mtArenaBlock {
+    struct mtArenaBlock* next;
+
+    size_t size;
+    size_t used;
+
+    // aligned to mtArenaAlignment
+    _Alignas(mtArenaAlignment) char data[];
+};
+
+struct mtArena {
+    struct mtArenaBlock* first;
+    struct mtArenaBlock* current;
+};
+
+struct mtArenaMark {
+    struct mtArenaBlock* block;
+    size_t used;
+};
+
+//@brief Creates an empty arena, no memory is allocated until the first mtArenaAlloc.
+void mtArenaCreate(struct mtArena* arena);
+
+//@brief Frees all the memory the arena holds.
+void mtArenaDestroy(struct mtArena* arena);
+
+//@brief Allocates size bytes, the memory is not zeroed.
+void* mtArenaAlloc(struct mtArena* arena, size_t size);
+
+//@returns a mark of the current position, which can be reset to with mtArenaReset.
+struct mtArenaMark mtArenaGetMark(struct mtArena* arena);
+
+//@brief Releases everything allocated after mark was taken.
+void mtArenaReset(struct mtArena* arena, struct mtArenaMark mark);
+
+//@brief Calls visit with every allocation that wasn't released yet, in the order they were made.
+// The arena doesn't know how big they were, so visit returns the size that was allocated.
+void mtArenaForEach(struct mtArena* arena, size_t (*visit)(void* allocation, void* userData), void* userData);
+
+#endif
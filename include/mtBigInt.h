@@ -0,0 +1,74 @@
+
+#ifndef mtBigInt_h
+#define mtBigInt_h
+
+/*
+*   Integers of any size, for the results that don't fit in an int64_t.
+*
+*   A big int is a sign and a magnitude in 32 bit limbs, least significant
+*   first, and it's never changed once it's made. Numbers only point to
+*   them, so copying a number just copies the pointer. They're freed by the
+*   garbage collector once no number points to them anymore, see mtGC.h
+*
+*   Every result that fits in an int64_t is given back as a plain integer,
+*   so each int has exactly one representation.
+*/
+
+#include <stdlib.h> // for size_t
+#include <stdint.h>
+#include <stdbool.h>
+
+// limbs in the shorter operand from which multiplying switches from schoolbook to Karatsuba.
+#define mtBigIntKaratsubaThreshold 32
+
+struct mtNumber;
+
+struct mtBigInt {
+    struct mtBigInt* next; // every big int there is, for mtBigIntSweep
+    bool marked;
+    bool kept; // it's a constant of the program, see mtBigIntKeep
+
+    bool negative;
+    size_t count;
+    uint32_t limbs[]; // the magnitude, the most significant one isn't 0
+};
+
+//@brief out = a (op) b, for a and b which are both ints, of either size.
+void mtBigIntAdd(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b);
+void mtBigIntSub(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b);
+void mtBigIntMul(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b);
+
+//@brief out = a / b, an int if b divides a and a decimal otherwise, like numberDiv.
+// b can't be 0.
+void mtBigIntDiv(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b);
+
+//@returns less than, equal to or greater than 0 if a is less than, equal to or greater than b.
+int mtBigIntCompare(const struct mtNumber* a, const struct mtNumber* b);
+
+//@returns the closest double to an int of either size, which can be infinite.
+double mtBigIntToDouble(const struct mtNumber* a);
+
+//@brief Writes big in decimal into out, cut to fit into size bytes like snprintf.
+//
+//@returns the length of the whole text, without the null terminator.
+size_t mtBigIntStr(const struct mtBigInt* big, char* out, size_t size);
+
+//@brief Reads the int written in decimal in the size bytes at digits, which can start with a sign.
+// digits doesn't have to be null terminated, and it's read the same way as mtBigIntStr writes it.
+void mtBigIntFromString(struct mtNumber* out, const char* digits, size_t size);
+
+//@brief Keeps big from ever being freed, for the ints in the program's own code.
+void mtBigIntKeep(struct mtBigInt* big);
+
+//@brief Keeps big from being freed by the next mtBigIntSweep.
+void mtBigIntMark(struct mtBigInt* big);
+
+//@brief Frees every big int which wasn't marked since the last sweep.
+//
+//@returns the bytes the big ints that are left take up.
+size_t mtBigIntSweep();
+
+//@returns the bytes allocated for big ints since the last sweep.
+size_t mtBigIntAllocatedSinceSweep();
+
+#endif
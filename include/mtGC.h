@@ -0,0 +1,72 @@
+
+#ifndef mtGC_h
+#define mtGC_h
+
+/*
+*   A mark-and-sweep garbage collector for mtObjects.
+*
+*   Every object made with mtCreateObject is tracked. A collection is started
+*   from mtCreateObject once enough objects were allocated since the last one,
+*   everything reachable from a root is kept and the rest is given back to
+*   the pool.
+*
+*   The roots are the scopes the interpreter is executing in and the
+*   temporaries it is still holding on to, both are kept on stacks which
+*   the interpreter pushes and pops as it goes.
+*
+*   Big ints are collected along with the objects, every one which isn't
+*   pointed to by a kept object or a temporary is freed, see Type.mark. So
+*   the interpreter only collects between statements and in mtCreateObject,
+*   where every number it still needs is in one of those.
+*/
+
+#include <stdlib.h> // for size_t
+#include <stdio.h> // for FILE
+#include <stdbool.h> // for bool
+
+#include "mtObject.h"
+#include "mtScope.h"
+
+// the number of allocations before the first collection.
+#define mtGCInitialThreshold    1024
+
+// the bytes of big ints allocated before the first collection.
+#define mtGCInitialBigIntThreshold  (1024 * 1024)
+
+struct mtGCStats {
+    size_t collections;
+
+    size_t allocated;   // in total
+    size_t freed;       // in total
+    size_t live;        // right now
+    size_t peakLive;
+
+    size_t threshold;   // allocations until the next collection
+};
+
+//@brief Collects if enough objects or big ints were allocated since the last collection,
+// called by mtCreateObject before it allocates and by the interpreter between statements.
+void mtGCMaybeCollect();
+
+//@brief Starts tracking object, called by mtCreateObject.
+void mtGCTrack(struct mtObject* object);
+
+//@brief Marks everything reachable from the roots then frees everything else.
+void mtGCCollect();
+
+//@brief Adds scope to the roots, until it is popped with mtGCPopScope
+void mtGCPushScope(struct mtScope* scope);
+void mtGCPopScope();
+
+//@brief Keeps a temporary alive until it's popped with mtGCPopTemps.
+//
+//@param object may be NULL, it still has to be popped.
+void mtGCPushTemp(struct mtObject* object);
+
+//@brief Pops the last count temporaries.
+void mtGCPopTemps(size_t count);
+
+struct mtGCStats mtGCGetStats();
+void mtGCPrintStats(FILE* stream);
+
+#endif
@@ -1,30 +1,70 @@
-#ifndef HashMap_h 
-#define HashMap_h 
+#ifndef HashMap_h
+#define HashMap_h
+
+/*
+*   A string to pointer table, with open addressing and Robin Hood probing.
+*
+*   The entries are kept in one array, an entry that had to probe further
+*   than the one in its slot takes the slot, so every key is close to where
+*   it hashes to. The table doubles once it's more than mtHashMapMaxLoad
+*   full, and removing shifts the entries after it back, there are no
+*   tombstones.
+*
+*   Keys are copied, short ones into the entry itself. The N functions take
+*   a key which isn't null-terminated, with its hash worked out beforehand
+*   by mtHashMapHash, so a key that's looked up often only has to be hashed
+*   once, ex: ASTNode.hash
+*/
 
 #include <stdlib.h> // for size_t
+#include <stdint.h>
+
+// keys shorter than this are kept in the entry instead of being allocated.
+#define mtHashMapInlineKeySize  24
+
+// the most entries per slot, in eighths, before the table grows.
+#define mtHashMapMaxLoad        7
+
+#define mtHashMapMinSize        8
 
 struct mtHashMapEntry {
-    const char* key;
-    void* value;
+    uint32_t hash;
+    uint32_t distance; // from the slot its hash points to, plus 1. 0 if the slot is empty
+    uint32_t size;     // of the key
 
-    struct mtHashMapEntry* next;
+    union {
+        char inlined[mtHashMapInlineKeySize]; // if size < mtHashMapInlineKeySize
+        char* allocated;
+    } key;
+
+    void* value;
 };
 
 struct mtHashMap {
-    struct mtHashMapEntry **buckets;
+    struct mtHashMapEntry* entries;
 
-    size_t size;
-    size_t count;    
+    size_t size;    // a power of 2
+    size_t count;
 };
 
-
+//@param initialSize the number of slots it starts with, rounded up to a power of 2.
 struct mtHashMap* mtHashMapCreate(size_t initialSize);
 void mtHashMapDestroy(struct mtHashMap* map, void (*free_value)(void*));
 
+//@returns the hash of the size bytes at key, what the N functions take.
+uint32_t mtHashMapHash(const char* key, size_t size);
+
 void mtHashMapPut(struct mtHashMap* map, const char* key, void* value);
+void mtHashMapPutN(struct mtHashMap* map, const char* key, size_t size, uint32_t hash, void* value);
 void mtHashMapRemove(struct mtHashMap* map, const char* key);
 
 //@returns the value of the key-value pair
 void* mtHashMapGet(struct mtHashMap* map, const char* key);
+void* mtHashMapGetN(struct mtHashMap* map, const char* key, size_t size, uint32_t hash);
+
+//@brief Calls callback with every value in the map, in no particular order.
+//
+//@param userData passed on to callback as is.
+void mtHashMapForEach(struct mtHashMap* map, void (*callback)(void* value, void* userData), void* userData);
 
 #endif // HASHMAP_H
@@ -4,15 +4,19 @@
 
 #include "internal/mtToken.h"
 #include "mtObject.h"
+#include "mtBigInt.h"
 
+// ints are 64 bit, and become big ints when a result doesn't fit, see mtBigInt.h
 struct mtNumber {
 	enum {
         INTEGER,
-        DECIMAL
+        DECIMAL,
+        BIGINT
     } type;
 	union {
-		int integer;
+		int64_t integer;
 		double decimal;	
+		struct mtBigInt* big;
 	};
 };
 
@@ -20,35 +24,27 @@ struct mtNumber {
 
 void numberSet(void* a, void* b);
 
-void* numberAdd(void* a, void* b);
-void* numberSub(void* a, void* b);
-void* numberDiv(void* a, void* b);
-void* numberMul(void* a, void* b);
+void numberAdd(void* out, void* a, void* b);
+void numberSub(void* out, void* a, void* b);
+void numberDiv(void* out, void* a, void* b);
+void numberMul(void* out, void* a, void* b);
 
 bool mtNumberIsEqual    (void* a, void* b);
 bool mtNumberIsGreater  (void* a, void* b);
 bool mtNumberIsLesser   (void* a, void* b);
 
-char* numberStr(void* a);
+size_t numberStr(void* a, char* buffer, size_t size);
 
-int mtInterpretInteger(struct Token* token);
-float mtInterpretDecimal(struct Token* token);
+//@brief Marks the big int a points to, if it's one, see mtGC.h
+void numberMark(void* a);
 
-static const struct Type mtNumberType = {
-    .size = sizeof(struct mtNumber),
+//@returns true for ints of any size, what type hints and mtInferTypes go by.
+bool mtNumberIsInteger(const struct mtNumber* number);
 
-    .set = &numberSet,
+//@brief Reads an integer literal, into a big int if it doesn't fit in an int64_t.
+void mtInterpretInteger(struct Token* token, struct mtNumber* out);
+double mtInterpretDecimal(struct Token* token);
 
-    .add = &numberAdd,
-    .sub = &numberSub,
-    .mul = &numberMul,
-    .div = &numberDiv,
-
-    .str = &numberStr,
-
-    .isGreater = mtNumberIsGreater,
-    .isLesser = mtNumberIsLesser,
-    .isEqual = mtNumberIsEqual
-};
+extern const struct Type mtNumberType;
 
 #endif // MT_NUMBER_H
@@ -5,30 +5,81 @@
 #include <stdlib.h> // for size_t
 #include <stdbool.h> // for bool
 
+#include "mtArena.h"
+
+// big enough for the text of any fixed size payload, see Type.str
+#define mtStrBufferSize 64
+
 struct Type {
     size_t size;
     
-    // set a to b
+    // set a to b, equal values have to end up with the same bytes in a
+    // since payloads are compared byte for byte, e.g. to look up cached results.
     void (*set)(void*, void*);
 
-    void* (*add)(void*, void*);
-    void* (*sub)(void*, void*);
-    void* (*mul)(void*, void*);
-    void* (*div)(void*, void*);
+    // out = a (op) b, out is a zeroed payload of the same type.
+    void (*add)(void*, void*, void*);
+    void (*sub)(void*, void*, void*);
+    void (*mul)(void*, void*, void*);
+    void (*div)(void*, void*, void*);
 
     bool (*isEqual)(void*, void*);
     bool (*isGreater)(void*, void*);
     bool (*isLesser)(void*, void*);
 
-    char* (*str)(void*);
+    // writes the payload as text into buffer, cut to fit into size bytes like snprintf,
+    // and returns the length of the whole text so a bigger buffer can be tried.
+    size_t (*str)(void*, char* buffer, size_t size);
+
+    // marks whatever the payload points to for the garbage collector, 
+    // NULL if payloads of the type don't point to anything, see mtGC.h
+    void (*mark)(void*);
 };
 
 struct mtObject {
-    struct Type type; 
+    const struct Type* type; 
     void* data;
+
+    // used by the garbage collector
+    struct mtObject* gcNext;
+    bool gcMarked;
+
+    // made with mtCreateTempObject
+    bool temporary;
+
+    // the value of a literal, shared by every evaluation of it, see ASTNode.literal.
+    // It's never written to, anything that could write to it gets a copy.
+    bool isConstant;
 };
 
-struct mtObject* mtCreateObject(struct Type type);
+//@brief Creates an object of type, the header and payload both come from the pool.
+// The object is owned by the garbage collector, see mtGC.h
+struct mtObject* mtCreateObject(const struct Type* type);
+
+//@brief Returns the object and its payload to the pool, only the garbage collector should call this.
+void mtFreeObject(struct mtObject* object);
+
+//@brief Creates a temporary object in the temporary arena, it isn't tracked by the 
+// garbage collector and only lives until the arena is reset past it.
+// Copy it into an object from mtCreateObject to keep it.
+struct mtObject* mtCreateTempObject(const struct Type* type);
+
+//@returns the current position of the temporary arena.
+struct mtArenaMark mtTempMark();
+
+//@brief Frees every temporary object created since mark.
+void mtTempRelease(struct mtArenaMark mark);
+
+//@brief Frees every temporary object created since mark except for keep,
+// which is copied into a new temporary object.
+//
+//@param keep may be NULL, or any object, not just a temporary one.
+//
+//@returns the copy of keep, or NULL.
+struct mtObject* mtTempReleaseKeeping(struct mtArenaMark mark, struct mtObject* keep);
+
+//@brief Calls callback with every temporary object that wasn't released yet.
+void mtTempForEach(void (*callback)(struct mtObject* object));
 
 
 #endif
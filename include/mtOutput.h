@@ -0,0 +1,68 @@
+
+#ifndef mtOutput_h
+#define mtOutput_h
+
+/*
+*   Where everything a program prints goes, instead of stdio.
+*
+*   Output is gathered in one big buffer and handed to the sink in large
+*   writes. The buffer is flushed when it's full, after every line if the
+*   sink is interactive, like a terminal someone is watching, and at exit.
+*   Anything written to stderr should call mtOutputFlush first, so errors
+*   still show up after the output that came before them.
+*
+*   The default sink writes to stdout's file descriptor. An embedder can set
+*   its own with mtOutputSetSink, to capture the output in memory or send it
+*   to another file descriptor, ex: mtOutputMemorySink.
+*/
+
+#include <stdlib.h> // for size_t
+#include <stdbool.h>
+
+#define mtOutputBufferSize  (64 * 1024)
+
+struct mtOutputSink {
+    //@returns the bytes it wrote, fewer than size only if it can't write anymore.
+    size_t (*write)(void* context, const char* data, size_t size);
+    void* context;
+
+    bool isInteractive; // flushed after every line
+};
+
+// the memory an mtOutputMemorySink collects into, data is null-terminated.
+struct mtOutputMemory {
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+//@brief Flushes what was written so far to the old sink, then writes to sink from now on.
+//
+//@param sink is copied, NULL goes back to the default sink.
+void mtOutputSetSink(const struct mtOutputSink* sink);
+
+//@returns a sink writing to the file descriptor fd, interactive if it's a terminal.
+struct mtOutputSink mtOutputFileSink(int fd);
+
+//@returns a sink which appends to memory, it has to be zeroed or freed with mtOutputMemoryFree.
+struct mtOutputSink mtOutputMemorySink(struct mtOutputMemory* memory);
+void mtOutputMemoryFree(struct mtOutputMemory* memory);
+
+void mtOutputWrite(const char* data, size_t size);
+
+//@brief Writes like printf.
+void mtOutputPrintf(const char* fmt, ...);
+
+//@brief Makes room to write into the buffer directly, what's written is only output once it's committed.
+//
+//@param size at most mtOutputBufferSize
+//@returns room for at least size bytes.
+char* mtOutputReserve(size_t size);
+
+//@brief Outputs the first size bytes of the room mtOutputReserve gave.
+void mtOutputCommit(size_t size);
+
+//@brief Hands everything buffered to the sink.
+void mtOutputFlush();
+
+#endif
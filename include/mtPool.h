@@ -0,0 +1,34 @@
+
+#ifndef mtPool_h
+#define mtPool_h
+
+/*
+*   A small-object allocator for the interpreter's fixed-size allocations,
+*   object headers and their payloads mostly.
+*
+*   Requests are rounded up to one of a few size classes, each with its own
+*   thread-local free list which is refilled a chunk at a time. Anything
+*   larger than the biggest class is passed straight on to malloc.
+*/
+
+#include <stdlib.h> // for size_t
+
+#define mtPoolSizeClassCount    4
+#define mtPoolMinBlockSize      16
+#define mtPoolMaxBlockSize      (mtPoolMinBlockSize << (mtPoolSizeClassCount - 1))
+
+// the number of bytes requested from the system each time a free list runs dry.
+#define mtPoolChunkSize         4096
+
+//@brief Allocates size bytes from the pool, the memory is not zeroed.
+//
+//@returns a pointer to the memory, release it with mtPoolFree using the same size.
+void* mtPoolAlloc(size_t size);
+
+//@brief Returns memory allocated with mtPoolAlloc to the pool.
+//
+//@param ptr the pointer mtPoolAlloc returned, may be NULL.
+//@param size the size that was passed to mtPoolAlloc.
+void mtPoolFree(void* ptr, size_t size);
+
+#endif
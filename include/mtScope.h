@@ -4,18 +4,63 @@
 
 #include "mtHashmap.h"
 
-// totally arbitrary
+struct mtObject;
+struct mtFunction;
+
+// totally arbitrary, the tables grow as they fill up.
 #define mtScopeDefaultSize 8
 
+// The tables are only created once something is written to them,
+// most blocks never declare anything so they never need one.
 struct mtScope {
     struct mtScope* parent;    
-    struct mtHashMap* variables;
-    struct mtHashMap* functions;
+    struct mtHashMap* variables; // could be NULL
+    struct mtHashMap* functions; // could be NULL
+
+    // variables bound by position instead of in a table, a call's arguments. 
+    // slotNames[i] is the name of slots[i], both could be NULL.
+    struct mtObject** slots;
+    const char** slotNames;
+    size_t slotCount;
 };
 
+//@brief Initializes a scope without allocating anything, so it can live on the stack.
+//
+//@param parent the scope above it, may be NULL.
+void mtInitScope(struct mtScope* scope, struct mtScope* parent);
+
+//@brief Frees the scope's tables, but not the scope itself.
+// The objects in it are left to the garbage collector.
+//
+//@param freeFunction called on every function in the scope, may be NULL.
+void mtReleaseScope(struct mtScope* scope, void (*freeFunction)(void*));
+
 struct mtScope* mtCreateScope();
 
+//@brief Frees the scope and its tables, the objects in it are left to the garbage collector.
+//
+//@param freeFunction called on every function in the scope, may be NULL.
+void mtDestroyScope(struct mtScope* scope, void (*freeFunction)(void*));
+
+//@brief Binds key to object in this scope, not any of its parents.
+void mtScopeSetObject(struct mtScope* scope, const char* key, struct mtObject* object);
+void mtScopeSetObjectN(struct mtScope* scope, const char* key, size_t size, uint32_t hash, struct mtObject* object);
+
+//@brief Binds key to function in this scope, not any of its parents.
+//
+//@returns the function that was bound to key before, or NULL.
+struct mtFunction* mtScopeSetFunction(struct mtScope* scope, const char* key, struct mtFunction* function);
+
+//@returns a counter which changes whenever the functions a lookup could find change,
+// that is when a function is bound or a scope with functions is released.
+// A function found while it had the same value can be reused without looking it up again.
+size_t mtScopeGetFunctionEpoch();
+
 struct mtObject* getObjectFromScope(struct mtScope* scope, const char* key);
 struct mtFunction* getFunctionFromScope(struct mtScope* scope, const char* key);
 
+//@brief Like the ones above, with a key that isn't null-terminated and its mtHashMapHash.
+struct mtObject* getObjectFromScopeN(struct mtScope* scope, const char* key, size_t size, uint32_t hash);
+struct mtFunction* getFunctionFromScopeN(struct mtScope* scope, const char* key, size_t size, uint32_t hash);
+
 #endif
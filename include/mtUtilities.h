@@ -150,7 +150,10 @@ int mtWhichOf(char character, char* set, size_t setSize);
 //      - trailing characters     
 //      - non-nullterminated string
 //@param base the Base to interpret the string in, eg Base2, Base10 etc. From 2 to 36.
-int mtStringToInt(int* out, char* str, int base);
+int mtStringToInt(int64_t* out, char* str, int base);
+
+//@brief Like mtStringToInt, for the size characters at str which don't have to be null terminated.
+int mtStringToIntN(int64_t* out, const char* str, size_t size, int base);
 
 //@brief Converts str into a float then writes it to out
 //
@@ -163,4 +166,21 @@ int mtStringToInt(int* out, char* str, int base);
 //		- trailing characters
 int mtStringToFloat(float* out, char* str);
 
+//@brief Converts the size characters at str into the closest double, they don't have to be null terminated.
+//
+//@param str [sign] digits [. digits] [e [sign] digits], digits can be left out on either side of the '.'
+//  Nothing else may come before or after it, not even spaces.
+int mtStringToDoubleN(double* out, const char* str, size_t size);
+
+//@brief Writes value in decimal into out, cut to fit into size bytes like snprintf.
+//
+//@returns the length of the whole text, without the null terminator.
+size_t mtIntToStringN(char* out, size_t size, int64_t value);
+
+//@brief Writes value with the fewest digits that read back as the same double into out, 
+// cut to fit into size bytes like snprintf. Ex: 0.1, 100.0, 1e+16, 1.5e-07, inf, nan
+//
+//@returns the length of the whole text, without the null terminator.
+size_t mtDoubleToStringN(char* out, size_t size, double value);
+
 #endif
@@ -7,26 +7,94 @@
 #include "mtExpression.h"
 #include "mtFunction.h"
 #include "mtIfStatement.h"
+#include "mtInterpreter.h"
+#include "mtLoop.h"
 
-void interpretBlock(struct ASTNode* node, struct mtScope* parent)
+static size_t printedResults = 0;
+
+//@brief Prints the result of a statement at the top level, or one a function call didn't return.
+static void printResult(struct mtObject* object)
 {
-    if (node->childCount <= 0)
+    printedResults++;
+
+    // formatted straight into the output buffer, with room for the newline.
+    char* buffer = mtOutputReserve(mtStrBufferSize + 1);
+    size_t length = object->type->str(object->data, buffer, mtStrBufferSize);
+    if (length < mtStrBufferSize)
     {
+        buffer[length] = '\n';
+        mtOutputCommit(length + 1);
         return;
     }
 
-    struct mtScope* scope = mtCreateScope(); 
-    scope->parent = parent;
+    // only big ints don't fit.
+    char* str = malloc(length + 2);
+    object->type->str(object->data, str, length + 1);
+    str[length] = '\n';
+    mtOutputWrite(str, length + 1);
+    free(str);
+}
+
+//@brief Prints the frame's result so far, the expression statement after it replaced it.
+static void printPending(struct mtCallFrame* frame)
+{
+    if (frame->result)
+    {
+        printResult(frame->result);
+        frame->result = NULL;
+    }
+}
+
+size_t mtGetPrintedResults()
+{
+    return printedResults;
+}
+
+struct mtObject* interpretBlock(struct ASTNode* node, struct mtScope* parent)
+{
+    if (node->childCount <= 0)
+    {
+        return NULL;
+    }
+
+    // the tables are only allocated if the block declares something.
+    struct mtScope blockScope;
+    mtInitScope(&blockScope, parent);
+
+    mtGCPushScope(&blockScope);
+    struct mtObject* result = interpretStatements(node, &blockScope);
+    mtGCPopScope();
+
+    // the functions belong to their definitions, not the scope.
+    mtReleaseScope(&blockScope, NULL);
+
+    return result;
+}
+
+struct mtObject* interpretStatements(struct ASTNode* node, struct mtScope* scope)
+{
+    struct mtCallFrame* frame = mtGetCurrentFrame();
+    struct mtObject* result = NULL;
+
     for (size_t i = 0; i < node->childCount; i++) 
     {
         struct mtObject* expression = NULL;
         
         struct ASTNode* currentNode = node->children[i];
+
+        // everything temporary the statement creates is freed once it's done.
+        struct mtArenaMark mark = mtTempMark();
       
         switch(currentNode->type)
         {
             case NodeType_IfStatement:
-                interpretIfStatement(currentNode, scope);
+                expression = interpretIfStatement(currentNode, scope);
+                break;
+            case NodeType_WhileLoop:
+                expression = interpretWhileLoop(currentNode, scope);
+                break;
+            case NodeType_ForLoop:
+                expression = interpretForLoop(currentNode, scope);
                 break;
             case NodeType_FunctionDefinition:
                 interpretFunctionDef(currentNode, scope);
@@ -37,15 +105,47 @@ void interpretBlock(struct ASTNode* node, struct mtScope* parent)
             
             case NodeType_BinaryOperator:
             case NodeType_FunctionCall:
+            case NodeType_Identifier:
+            case NodeType_Number:
+            case NodeType_Constant:
+                // only a call can be without a result, anything else replaces the one before
+                // it, which is printed first so the results come out in the order they ran.
+                if (frame && currentNode->type != NodeType_FunctionCall)
+                {
+                    printPending(frame);
+                }
+
                 expression = interpretExpression(currentNode, scope); 
-                if (expression)
+                if (expression && !frame)
                 {
-                    printf("%s\n", expression->type.str(expression->data));
+                    printResult(expression);
+                } else if (expression) {
+                    printPending(frame);
                 }
                 break;
             
             default:
                 break;
         }
+
+        if (expression && frame)
+        {
+            // the result has to outlive the statement that made it.
+            result = mtTempReleaseKeeping(mark, expression);
+            frame->result = result;
+        } else {
+            mtTempRelease(mark);
+        }
+
+        // the big ints a statement made and didn't keep can be freed.
+        mtGCMaybeCollect();
+
+        // a call in tail position was made, the frame's function runs next.
+        if ((frame && frame->tailCall) || mtIsHalted())
+        {
+            break;
+        }
     }
+
+    return result;
 }
@@ -4,6 +4,20 @@
 
 #include "mtAST.h" 
 
-void interpretBlock(struct ASTNode* node, struct mtScope* parent);
+//@brief Runs every statement in node, in a new scope below parent.
+//
+// At the top level the result of every expression statement is printed, 
+// inside a function call the last one that runs is the call's result and the
+// ones before it are printed, see mtCallFrame.result
+//
+//@returns the result of the last expression statement that ran, as a temporary object, or NULL.
+struct mtObject* interpretBlock(struct ASTNode* node, struct mtScope* parent);
+
+//@brief Runs every statement in node directly in scope, like interpretBlock 
+// but without a scope of its own, so loops can reuse one scope for every iteration.
+struct mtObject* interpretStatements(struct ASTNode* node, struct mtScope* scope);
+
+//@returns how many results were printed so far, a call which printed any can't be memoized.
+size_t mtGetPrintedResults();
 
 #endif
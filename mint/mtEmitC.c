@@ -0,0 +1,1272 @@
+#include "mtEmitC.h"
+
+#include <stdarg.h>
+#include <inttypes.h>
+
+#include <Mint.h>
+
+// the helpers every emitted program starts with, the arithmetic itself comes from mtRuntime.
+static const char* preamble =
+    "#include <stdbool.h>\n"
+    "#include <stdint.h>\n"
+    "#include <stdio.h>\n"
+    "#include <stdlib.h>\n"
+    "#include <string.h>\n"
+    "\n"
+    "#include <mtNumberObject.h>\n"
+    "#include <mtBigInt.h>\n"
+    "#include <mtOutput.h>\n"
+    "\n"
+    "static inline struct mtNumber mtInt(int64_t value)\n"
+    "{\n"
+    "    struct mtNumber out = { .type = INTEGER, .integer = value };\n"
+    "    return out;\n"
+    "}\n"
+    "\n"
+    "static inline struct mtNumber mtDecimal(double value)\n"
+    "{\n"
+    "    struct mtNumber out = { .type = DECIMAL, .decimal = value };\n"
+    "    return out;\n"
+    "}\n"
+    "\n"
+    "static inline struct mtNumber mtBig(const char* digits)\n"
+    "{\n"
+    "    struct mtNumber out = { 0 };\n"
+    "    mtBigIntFromString(&out, digits, strlen(digits));\n"
+    "    return out;\n"
+    "}\n"
+    "\n"
+    "#define mtOperator(name, function)                                          \\\n"
+    "    static inline struct mtNumber name(struct mtNumber a, struct mtNumber b) \\\n"
+    "    {                                                                       \\\n"
+    "        struct mtNumber out = { 0 };                                        \\\n"
+    "        function(&out, &a, &b);                                             \\\n"
+    "        return out;                                                         \\\n"
+    "    }\n"
+    "\n"
+    "mtOperator(mtAdd, numberAdd)\n"
+    "mtOperator(mtSub, numberSub)\n"
+    "mtOperator(mtMul, numberMul)\n"
+    "mtOperator(mtDiv, numberDiv)\n"
+    "\n"
+    "static inline bool mtGreater(struct mtNumber a, struct mtNumber b) { return mtNumberIsGreater(&a, &b); }\n"
+    "static inline bool mtLesser(struct mtNumber a, struct mtNumber b) { return mtNumberIsLesser(&a, &b); }\n"
+    "static inline bool mtEqual(struct mtNumber a, struct mtNumber b) { return mtNumberIsEqual(&a, &b); }\n"
+    "\n"
+    "static inline void mtPrint(struct mtNumber value)\n"
+    "{\n"
+    "    char* buffer = mtOutputReserve(mtStrBufferSize + 1);\n"
+    "    size_t length = numberStr(&value, buffer, mtStrBufferSize);\n"
+    "    if (length < mtStrBufferSize)\n"
+    "    {\n"
+    "        buffer[length] = '\\n';\n"
+    "        mtOutputCommit(length + 1);\n"
+    "        return;\n"
+    "    }\n"
+    "\n"
+    "    char* str = malloc(length + 2);\n"
+    "    numberStr(&value, str, length + 1);\n"
+    "    str[length] = '\\n';\n"
+    "    mtOutputWrite(str, length + 1);\n"
+    "    free(str);\n"
+    "}\n"
+    "\n"
+    "static inline void mtNoResult(const char* function)\n"
+    "{\n"
+    "    mtOutputFlush();\n"
+    "    fprintf(stderr, \"\\\"%s\\\" was used as a value but has no result!\\n\", function);\n"
+    "    exit(1);\n"
+    "}\n"
+    "\n"
+    "static inline int64_t mtBound(struct mtNumber value)\n"
+    "{\n"
+    "    if (value.type != INTEGER)\n"
+    "    {\n"
+    "        mtOutputFlush();\n"
+    "        fprintf(stderr, \"The first and last value of a for loop must be integers!\\n\");\n"
+    "        exit(1);\n"
+    "    }\n"
+    "    return value.integer;\n"
+    "}\n";
+
+struct NameList {
+    char** names;
+    size_t count;
+    size_t capacity;
+};
+
+struct FunctionInfo {
+    struct ASTNode* node;
+    char* name;
+
+    struct NameList parameters;
+
+    enum {
+        Purity_Unknown,
+        Purity_Checking,
+        Purity_Pure,
+        Purity_Impure
+    } purity; // see isPure
+};
+
+// the variables of a block being written, like an mtScope of the interpreter.
+struct BlockScope {
+    struct NameList variables; // the ones it has at this point of the block
+
+    // a loop's own variables are declared before it, whether they exist
+    // depends on an earlier iteration, so they're only read once assigned.
+    struct NameList loopVariables;
+
+    bool isRoot; // its variables are the globals
+};
+
+enum Symbol {
+    Symbol_None,
+    Symbol_Counter,
+    Symbol_Parameter,
+    Symbol_Local,
+    Symbol_Global
+};
+
+struct CEmitter {
+    FILE* out;
+    int indent;
+
+    struct NameList globals; // everything the top level assigns
+
+    // names that could be found through dynamic scoping, functions can't read or write
+    // globals with these names, which variable they'd get depends on who called them.
+    struct NameList shadowing;
+
+    struct FunctionInfo* functions;
+    size_t functionCount;
+
+    struct FunctionInfo* function; // the function being written, NULL at the top level
+    struct NameList counters; // the loop counters in scope, the innermost last
+
+    struct BlockScope* blocks; // the innermost last
+    size_t blockCount;
+    size_t blockCapacity;
+    size_t loopCount;
+
+    bool failed;
+};
+
+static bool nameListContains(struct NameList* list, const char* name)
+{
+    for (size_t i = 0; i < list->count; i++)
+    {
+        if (strcmp(list->names[i], name) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void nameListPush(struct NameList* list, const char* name)
+{
+    if (list->count >= list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : 8;
+        list->names = realloc(list->names, sizeof(char*) * list->capacity);
+    }
+    list->names[list->count++] = strdup(name);
+}
+
+static void nameListAdd(struct NameList* list, const char* name)
+{
+    if (!nameListContains(list, name))
+    {
+        nameListPush(list, name);
+    }
+}
+
+static void nameListPop(struct NameList* list)
+{
+    free(list->names[--list->count]);
+}
+
+static void nameListFree(struct NameList* list)
+{
+    while (list->count > 0)
+    {
+        nameListPop(list);
+    }
+    free(list->names);
+}
+
+static char* tokenName(struct Token token)
+{
+    return strndup(token.string, token.size);
+}
+
+static void emitError(struct CEmitter* e, struct ASTNode* node, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    fprintf(stderr, "Can't emit C for line %d: \n\t", node->token.line);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+
+    va_end(args);
+    e->failed = true;
+}
+
+//@brief Writes a line of code at the current indentation.
+static void line(struct CEmitter* e, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    fprintf(e->out, "%*s", e->indent * 4, "");
+    vfprintf(e->out, fmt, args);
+    fprintf(e->out, "\n");
+
+    va_end(args);
+}
+
+static struct FunctionInfo* findFunction(struct CEmitter* e, const char* name)
+{
+    for (size_t i = 0; i < e->functionCount; i++)
+    {
+        if (strcmp(e->functions[i].name, name) == 0)
+        {
+            return &e->functions[i];
+        }
+    }
+    return NULL;
+}
+
+// ___________ collecting the names ______________
+
+//@brief Finds the globals, the functions and the top level's loop counters and block variables.
+static void collectTopLevel(struct CEmitter* e, struct ASTNode* block, bool isRoot)
+{
+    for (size_t i = 0; i < block->childCount; i++)
+    {
+        struct ASTNode* node = block->children[i];
+        switch (node->type)
+        {
+            case NodeType_FunctionDefinition:
+            {
+                char* name = tokenName(node->children[0]->token);
+                if (!isRoot)
+                {
+                    emitError(e, node->children[0], "\"%s\" has to be defined at the top level.", name);
+                    free(name);
+                    break;
+                }
+                if (findFunction(e, name))
+                {
+                    emitError(e, node->children[0], "\"%s\" is defined more than once.", name);
+                    free(name);
+                    break;
+                }
+
+                e->functions = realloc(e->functions, sizeof(struct FunctionInfo) * (e->functionCount + 1));
+                struct FunctionInfo* info = &e->functions[e->functionCount++];
+                memset(info, 0, sizeof(struct FunctionInfo));
+                info->node = node;
+                info->name = name;
+                break;
+            }
+
+            case NodeType_Assignment:
+            {
+                // a block's variable only lives as long as the block, unless the top level had it already.
+                char* name = tokenName(node->children[0]->token);
+                if (isRoot)
+                {
+                    nameListAdd(&e->globals, name);
+                } else if (!nameListContains(&e->globals, name)) {
+                    nameListAdd(&e->shadowing, name);
+                }
+                free(name);
+                break;
+            }
+
+            case NodeType_IfStatement:
+            case NodeType_WhileLoop:
+                collectTopLevel(e, node->children[1], false);
+                break;
+
+            case NodeType_ForLoop:
+            {
+                char* name = tokenName(node->children[0]->token);
+                nameListAdd(&e->shadowing, name);
+                free(name);
+
+                collectTopLevel(e, node->children[3], false);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+//@brief Finds the variables info's blocks could have, callers can't read globals with their names.
+static void collectLocals(struct CEmitter* e, struct FunctionInfo* info, struct ASTNode* block)
+{
+    for (size_t i = 0; i < block->childCount; i++)
+    {
+        struct ASTNode* node = block->children[i];
+        switch (node->type)
+        {
+            case NodeType_FunctionDefinition:
+                emitError(e, node, "Functions can only be defined at the top level, not in \"%s\".", info->name);
+                break;
+
+            case NodeType_Assignment:
+            {
+                // assigning to a global changes it, like it would in the interpreter.
+                char* name = tokenName(node->children[0]->token);
+                if (!nameListContains(&info->parameters, name) && !nameListContains(&e->globals, name))
+                {
+                    nameListAdd(&e->shadowing, name);
+                }
+                free(name);
+                break;
+            }
+
+            case NodeType_IfStatement:
+            case NodeType_WhileLoop:
+                collectLocals(e, info, node->children[1]);
+                break;
+
+            case NodeType_ForLoop:
+            {
+                char* name = tokenName(node->children[0]->token);
+                nameListAdd(&e->shadowing, name);
+                free(name);
+
+                collectLocals(e, info, node->children[3]);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+static void collectFunction(struct CEmitter* e, struct FunctionInfo* info)
+{
+    struct ASTNode* parameterList = info->node->children[1];
+    for (size_t i = 0; i < parameterList->childCount; i++)
+    {
+        char* name = tokenName(parameterList->children[i]->token);
+        nameListPush(&info->parameters, name);
+        nameListAdd(&e->shadowing, name);
+        free(name);
+    }
+
+    collectLocals(e, info, info->node->children[2]);
+}
+
+// ___________ writing the code ______________
+
+static void pushBlock(struct CEmitter* e, bool isRoot)
+{
+    if (e->blockCount >= e->blockCapacity)
+    {
+        e->blockCapacity = e->blockCapacity ? e->blockCapacity * 2 : 8;
+        e->blocks = realloc(e->blocks, sizeof(struct BlockScope) * e->blockCapacity);
+    }
+
+    struct BlockScope* block = &e->blocks[e->blockCount++];
+    memset(block, 0, sizeof(struct BlockScope));
+    block->isRoot = isRoot;
+}
+
+static void popBlock(struct CEmitter* e)
+{
+    struct BlockScope* block = &e->blocks[--e->blockCount];
+    nameListFree(&block->variables);
+    nameListFree(&block->loopVariables);
+}
+
+//@returns the innermost block with a variable called name, or NULL.
+//
+//@param isLoopVariable set if it's one of the block's loop variables, see BlockScope.
+static struct BlockScope* findVariable(struct CEmitter* e, const char* name, bool* isLoopVariable)
+{
+    for (size_t i = e->blockCount; i-- > 0; )
+    {
+        struct BlockScope* block = &e->blocks[i];
+        if (nameListContains(&block->variables, name))
+        {
+            *isLoopVariable = false;
+            return block;
+        }
+        if (nameListContains(&block->loopVariables, name))
+        {
+            *isLoopVariable = true;
+            return block;
+        }
+    }
+    return NULL;
+}
+
+//@returns what reading name at this point of the program reads.
+static enum Symbol resolve(struct CEmitter* e, struct ASTNode* node, const char* name)
+{
+    if (nameListContains(&e->counters, name))
+    {
+        return Symbol_Counter;
+    }
+
+    bool isLoopVariable = false;
+    struct BlockScope* block = findVariable(e, name, &isLoopVariable);
+    if (block && isLoopVariable)
+    {
+        emitError(e, node, "\"%s\" is only defined if an earlier iteration of the loop assigned it.", name);
+        return Symbol_None;
+    }
+    if (block)
+    {
+        return block->isRoot ? Symbol_Global : Symbol_Local;
+    }
+
+    if (e->function && nameListContains(&e->function->parameters, name))
+    {
+        return Symbol_Parameter;
+    }
+    if (e->function && nameListContains(&e->globals, name))
+    {
+        if (nameListContains(&e->shadowing, name))
+        {
+            emitError(e, node, "\"%s\" in \"%s\" could be a variable of the caller, it depends on dynamic scoping.",
+                      name, e->function->name);
+            return Symbol_None;
+        }
+        return Symbol_Global;
+    }
+
+    // a variable of a block that ended is gone, like in the interpreter.
+    emitError(e, node, "\"%s\" isn't defined.", name);
+    return Symbol_None;
+}
+
+//@returns what assigning to name at this point of the program assigns to.
+//
+//@param isNew set if it becomes a variable of the innermost block, once it's assigned.
+//@param declare set if that variable has to be declared, the loop's and the globals already are.
+static enum Symbol resolveAssignment(struct CEmitter* e, struct ASTNode* node, const char* name, 
+                                     bool* isNew, bool* declare)
+{
+    *isNew = false;
+    *declare = false;
+    if (nameListContains(&e->counters, name))
+    {
+        return Symbol_Counter;
+    }
+
+    struct BlockScope* current = &e->blocks[e->blockCount - 1];
+    bool isLoopVariable = false;
+    struct BlockScope* block = findVariable(e, name, &isLoopVariable);
+    if (block && isLoopVariable && block != current)
+    {
+        emitError(e, node, "Which \"%s\" is assigned depends on whether an earlier iteration of the loop assigned it.", name);
+        return Symbol_None;
+    }
+    if (block && !isLoopVariable)
+    {
+        return block->isRoot ? Symbol_Global : Symbol_Local;
+    }
+
+    if (!block)
+    {
+        if (e->function && nameListContains(&e->function->parameters, name))
+        {
+            return Symbol_Parameter;
+        }
+        if (e->function && nameListContains(&e->globals, name))
+        {
+            return Symbol_Global;
+        }
+        *declare = !current->isRoot;
+    }
+
+    *isNew = true;
+    return current->isRoot ? Symbol_Global : Symbol_Local;
+}
+
+//@brief Finds the variables the body of a loop assigns which don't exist before the loop,
+// they belong to the loop's scope, which is kept for every iteration.
+static void collectLoopVariables(struct CEmitter* e, struct ASTNode* body, const char* counter, struct NameList* out)
+{
+    for (size_t i = 0; i < body->childCount; i++)
+    {
+        struct ASTNode* node = body->children[i];
+        if (node->type != NodeType_Assignment)
+        {
+            continue;
+        }
+
+        char* name = tokenName(node->children[0]->token);
+        bool isLoopVariable = false;
+        bool exists = (counter && strcmp(name, counter) == 0) ||
+                      nameListContains(&e->counters, name) ||
+                      findVariable(e, name, &isLoopVariable) ||
+                      (e->function && (nameListContains(&e->function->parameters, name) || 
+                                       nameListContains(&e->globals, name)));
+        if (!exists)
+        {
+            nameListAdd(out, name);
+        }
+        free(name);
+    }
+}
+
+static void emitExpression(struct CEmitter* e, struct ASTNode* node);
+
+//@brief Writes an argument as a pointer, variables are passed by reference.
+static void emitArgument(struct CEmitter* e, struct ASTNode* node)
+{
+    if (node->type != NodeType_Identifier)
+    {
+        fprintf(e->out, "(struct mtNumber[]){ ");
+        emitExpression(e, node);
+        fprintf(e->out, " }");
+        return;
+    }
+
+    char* name = tokenName(node->token);
+    enum Symbol symbol = resolve(e, node, name);
+    fprintf(e->out, symbol == Symbol_Parameter ? "mt_%s" : "&mt_%s", name);
+    free(name);
+}
+
+static void emitArguments(struct CEmitter* e, struct ASTNode* argumentList, bool first)
+{
+    for (size_t i = 0; i < argumentList->childCount; i++)
+    {
+        if (!first || i > 0)
+        {
+            fprintf(e->out, ", ");
+        }
+        emitArgument(e, argumentList->children[i]);
+    }
+}
+
+//@returns the function node calls, after checking the arguments match.
+static struct FunctionInfo* getCallee(struct CEmitter* e, struct ASTNode* node)
+{
+    char* name = tokenName(node->children[0]->token);
+    struct FunctionInfo* callee = findFunction(e, name);
+    if (!callee)
+    {
+        emitError(e, node, "No such function \"%s\"!", name);
+    } else if (callee->parameters.count != node->children[1]->childCount)
+    {
+        emitError(e, node, "\"%s\" expects %zu arguments!", name, callee->parameters.count);
+        callee = NULL;
+    }
+
+    free(name);
+    return callee;
+}
+
+static void emitExpression(struct CEmitter* e, struct ASTNode* node)
+{
+    if (e->failed || node == NULL)
+    {
+        e->failed = true;
+        return;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Number:
+        {
+            if (node->token.type == TokenType_DecimalLiteral)
+            {
+                // 17 digits are enough to get the exact same double back.
+                fprintf(e->out, "mtDecimal(%.17g)", mtInterpretDecimal(&node->token));
+                return;
+            }
+
+            struct mtNumber number;
+            mtInterpretInteger(&node->token, &number);
+            if (number.type == BIGINT)
+            {
+                // it's read from its digits when it runs, like the interpreter reads it.
+                fprintf(e->out, "mtBig(\"%.*s\")", (int)node->token.size, node->token.string);
+            } else {
+                fprintf(e->out, "mtInt(%" PRId64 ")", number.integer);
+            }
+            return;
+        }
+
+        case NodeType_Identifier:
+        {
+            char* name = tokenName(node->token);
+            enum Symbol symbol = resolve(e, node, name);
+            fprintf(e->out, symbol == Symbol_Parameter ? "(*mt_%s)" : "mt_%s", name);
+            free(name);
+            return;
+        }
+
+        case NodeType_FunctionCall:
+        {
+            struct FunctionInfo* callee = getCallee(e, node);
+            if (!callee)
+            {
+                return;
+            }
+            fprintf(e->out, "mt_%s_value(", callee->name);
+            emitArguments(e, node->children[1], true);
+            fprintf(e->out, ")");
+            return;
+        }
+
+        case NodeType_BinaryOperator:
+            break;
+
+        default:
+            emitError(e, node, "Expected an expression.");
+            return;
+    }
+
+    const char* function = NULL;
+    switch (node->token.type)
+    {
+        case TokenType_OperatorAddition:        function = "mtAdd"; break;
+        case TokenType_OperatorSubtraction:     function = "mtSub"; break;
+        case TokenType_OperatorMultiplication:  function = "mtMul"; break;
+        case TokenType_OperatorDivision:        function = "mtDiv"; break;
+        default:
+            emitError(e, node, "Unknown operator.");
+            return;
+    }
+
+    fprintf(e->out, "%s(", function);
+    emitExpression(e, node->children[0]);
+    fprintf(e->out, ", ");
+    emitExpression(e, node->children[1]);
+    fprintf(e->out, ")");
+}
+
+static void emitCondition(struct CEmitter* e, struct ASTNode* node)
+{
+    if (node == NULL || node->childCount < 2)
+    {
+        e->failed = true;
+        return;
+    }
+
+    const char* function = NULL;
+    switch (node->type)
+    {
+        case NodeType_GreaterThan:          function = "mtGreater(";  break;
+        case NodeType_LesserThan:           function = "mtLesser(";   break;
+        case NodeType_IsEqual:              function = "mtEqual(";    break;
+        case NodeType_IsNotEqual:           function = "!mtEqual(";   break;
+        // like the interpreter, greater or equal is the same as not lesser.
+        case NodeType_GreaterThanOrEqual:   function = "!mtLesser(";  break;
+        case NodeType_LesserThanOrEqual:    function = "!mtGreater("; break;
+        default:
+            emitError(e, node, "Expected a condition.");
+            return;
+    }
+
+    fprintf(e->out, "%s", function);
+    emitExpression(e, node->children[0]);
+    fprintf(e->out, ", ");
+    emitExpression(e, node->children[1]);
+    fprintf(e->out, ")");
+}
+
+static void emitStatements(struct CEmitter* e, struct ASTNode* block);
+
+//@brief Writes the block of an if statement, it has a scope of its own every time it runs.
+static void emitBlock(struct CEmitter* e, struct ASTNode* block)
+{
+    pushBlock(e, false);
+    line(e, "{");
+    e->indent++;
+    emitStatements(e, block);
+    e->indent--;
+    line(e, "}");
+    popBlock(e);
+}
+
+//@brief Declares a loop's variables in a block around the loop, so every iteration has the same ones.
+static void beginLoopVariables(struct CEmitter* e, struct NameList* variables)
+{
+    if (variables->count == 0)
+    {
+        return;
+    }
+
+    line(e, "{");
+    e->indent++;
+    for (size_t i = 0; i < variables->count; i++)
+    {
+        line(e, "struct mtNumber mt_%s = { 0 };", variables->names[i]);
+    }
+}
+
+static void endLoopVariables(struct CEmitter* e, struct NameList* variables)
+{
+    if (variables->count > 0)
+    {
+        e->indent--;
+        line(e, "}");
+    }
+    nameListFree(variables);
+}
+
+//@brief Starts the scope a loop's condition and body run in.
+static void pushLoopBlock(struct CEmitter* e, struct NameList* variables)
+{
+    pushBlock(e, false);
+    for (size_t i = 0; i < variables->count; i++)
+    {
+        nameListPush(&e->blocks[e->blockCount - 1].loopVariables, variables->names[i]);
+    }
+}
+
+static void emitWhileLoop(struct CEmitter* e, struct ASTNode* node)
+{
+    struct NameList variables = { 0 };
+    collectLoopVariables(e, node->children[1], NULL, &variables);
+    beginLoopVariables(e, &variables);
+
+    // the condition is evaluated in the loop's scope too.
+    pushLoopBlock(e, &variables);
+    fprintf(e->out, "%*swhile (", e->indent * 4, "");
+    emitCondition(e, node->children[0]);
+    fprintf(e->out, ")\n");
+
+    line(e, "{");
+    e->indent++;
+    emitStatements(e, node->children[1]);
+    e->indent--;
+    line(e, "}");
+    popBlock(e);
+
+    endLoopVariables(e, &variables);
+}
+
+static void emitAssignment(struct CEmitter* e, struct ASTNode* node)
+{
+    char* name = tokenName(node->children[0]->token);
+
+    bool isNew = false;
+    bool declare = false;
+    enum Symbol symbol = resolveAssignment(e, node, name, &isNew, &declare);
+
+    fprintf(e->out, "%*s", e->indent * 4, "");
+    if (declare)
+    {
+        fprintf(e->out, "struct mtNumber ");
+    }
+    fprintf(e->out, symbol == Symbol_Parameter ? "*mt_%s = " : "mt_%s = ", name);
+    emitExpression(e, node->children[1]);
+    fprintf(e->out, ";\n");
+
+    // like in the interpreter, the variable only exists once its value was evaluated.
+    if (isNew)
+    {
+        nameListAdd(&e->blocks[e->blockCount - 1].variables, name);
+    }
+    free(name);
+}
+
+static void emitForLoop(struct CEmitter* e, struct ASTNode* node)
+{
+    // children: counter, first, last, block
+    size_t loop = e->loopCount++;
+    char* name = tokenName(node->children[0]->token);
+
+    struct NameList variables = { 0 };
+    collectLoopVariables(e, node->children[3], name, &variables);
+    beginLoopVariables(e, &variables);
+
+    // the count is a C int, the body sees a copy of it, like in the interpreter.
+    fprintf(e->out, "%*s", e->indent * 4, "");
+    fprintf(e->out, "for (int64_t mtCount%zu = mtBound(", loop);
+    emitExpression(e, node->children[1]);
+    fprintf(e->out, "), mtLast%zu = mtBound(", loop);
+    emitExpression(e, node->children[2]);
+    fprintf(e->out, "); mtCount%zu <= mtLast%zu; mtCount%zu++)\n", loop, loop, loop);
+
+    line(e, "{");
+    e->indent++;
+    line(e, "struct mtNumber mt_%s = mtInt(mtCount%zu);", name, loop);
+
+    nameListPush(&e->counters, name);
+    pushLoopBlock(e, &variables);
+    emitStatements(e, node->children[3]);
+    popBlock(e);
+    nameListPop(&e->counters);
+
+    // checked before incrementing, so a last value of INT_MAX doesn't overflow.
+    line(e, "if (mtCount%zu == mtLast%zu) break;", loop, loop);
+    e->indent--;
+    line(e, "}");
+
+    endLoopVariables(e, &variables);
+    free(name);
+}
+
+//@returns the call in block whose result would be the function's result, like markTailCalls in mtFunction.c
+static struct ASTNode* getTailCall(struct ASTNode* block)
+{
+    if (block == NULL || block->childCount == 0)
+    {
+        return NULL;
+    }
+
+    struct ASTNode* last = block->children[block->childCount - 1];
+    if (last->type == NodeType_FunctionCall)
+    {
+        return last;
+    }
+    if (last->type == NodeType_IfStatement && last->childCount > 1)
+    {
+        return getTailCall(last->children[1]);
+    }
+    return NULL;
+}
+
+static bool isFunctionPure(struct CEmitter* e, struct FunctionInfo* info, bool* assumed);
+
+//@brief Checks whether node only reads parameters of info and calls pure functions.
+//
+//@param assumed set if it's only pure if a function that is still being checked is.
+static bool isNodePure(struct CEmitter* e, struct FunctionInfo* info, struct ASTNode* node, bool* assumed)
+{
+    if (node == NULL)
+    {
+        return true;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Number:
+        case NodeType_Constant:
+            return true;
+
+        case NodeType_Identifier:
+        {
+            char* name = tokenName(node->token);
+            bool out = nameListContains(&info->parameters, name);
+            free(name);
+            return out;
+        }
+
+        case NodeType_FunctionCall:
+        {
+            char* name = tokenName(node->children[0]->token);
+            struct FunctionInfo* callee = findFunction(e, name);
+            free(name);
+
+            return callee && isFunctionPure(e, callee, assumed) && isNodePure(e, info, node->children[1], assumed);
+        }
+
+        case NodeType_BinaryOperator:
+        case NodeType_Block:
+        case NodeType_IfStatement:
+        case NodeType_ArgumentList:
+        case NodeType_GreaterThan:
+        case NodeType_LesserThan:
+        case NodeType_GreaterThanOrEqual:
+        case NodeType_LesserThanOrEqual:
+        case NodeType_IsEqual:
+        case NodeType_IsNotEqual:
+            break;
+
+        default:
+            return false;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        if (!isNodePure(e, info, node->children[i], assumed))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isFunctionPure(struct CEmitter* e, struct FunctionInfo* info, bool* assumed)
+{
+    switch (info->purity)
+    {
+        case Purity_Pure:
+            return true;
+        case Purity_Impure:
+            return false;
+        case Purity_Checking:
+            // a recursive call, it's pure if the rest of the function is.
+            *assumed = true;
+            return true;
+        default:
+            break;
+    }
+
+    bool dependsOnOthers = false;
+    info->purity = Purity_Checking;
+    bool out = isNodePure(e, info, info->node->children[2], &dependsOnOthers);
+
+    if (!out)
+    {
+        info->purity = Purity_Impure;
+    } else if (dependsOnOthers) {
+        // it's checked again once the function it depends on is done.
+        info->purity = Purity_Unknown;
+        *assumed = true;
+    } else {
+        info->purity = Purity_Pure;
+    }
+    return out;
+}
+
+//@returns true if info only reads its parameters and calls functions that do the same, 
+// like isPure in mtFunction.c, the interpreter only reuses the frame for tail calls to those.
+static bool isPure(struct CEmitter* e, struct FunctionInfo* info)
+{
+    bool assumed = false;
+    bool out = isFunctionPure(e, info, &assumed);
+
+    // nothing above info was being checked, so the only assumption was about info itself.
+    if (out && assumed)
+    {
+        info->purity = Purity_Pure;
+    }
+    return out;
+}
+
+static bool isSelfTailCall(struct CEmitter* e, struct ASTNode* node)
+{
+    if (!e->function || node->type != NodeType_FunctionCall || !node->isTailCall)
+    {
+        return false;
+    }
+
+    char* name = tokenName(node->children[0]->token);
+    bool out = strcmp(name, e->function->name) == 0;
+    free(name);
+
+    return out && isPure(e, e->function);
+}
+
+//@brief Writes a call of the function being written, in tail position, as a jump to its start.
+// The arguments are passed like the interpreter passes them when it reuses the frame,
+// variables by reference and everything else through the function's own copies.
+static void emitSelfTailCall(struct CEmitter* e, struct ASTNode* node)
+{
+    if (!getCallee(e, node))
+    {
+        return;
+    }
+
+    struct ASTNode* argumentList = node->children[1];
+    line(e, "{");
+    e->indent++;
+
+    // all of them are evaluated before any parameter changes.
+    for (size_t i = 0; i < argumentList->childCount; i++)
+    {
+        struct ASTNode* argument = argumentList->children[i];
+        fprintf(e->out, "%*s", e->indent * 4, "");
+        if (argument->type == NodeType_Identifier)
+        {
+            fprintf(e->out, "struct mtNumber* mtNext%zu = ", i);
+            emitArgument(e, argument);
+        } else {
+            fprintf(e->out, "struct mtNumber mtNext%zu = ", i);
+            emitExpression(e, argument);
+        }
+        fprintf(e->out, ";\n");
+    }
+
+    for (size_t i = 0; i < argumentList->childCount; i++)
+    {
+        const char* parameter = e->function->parameters.names[i];
+        if (argumentList->children[i]->type == NodeType_Identifier)
+        {
+            line(e, "mt_%s = mtNext%zu;", parameter, i);
+        } else {
+            line(e, "mtOwned[%zu] = mtNext%zu;", i, i);
+            line(e, "mt_%s = &mtOwned[%zu];", parameter, i);
+        }
+    }
+    line(e, "goto mtTailCall;");
+
+    e->indent--;
+    line(e, "}");
+}
+
+//@brief Writes an expression statement, at the top level it's printed,
+// in a function it becomes the result and the result before it is printed, like interpretStatements.
+static void emitExpressionStatement(struct CEmitter* e, struct ASTNode* node)
+{
+    if (isSelfTailCall(e, node))
+    {
+        emitSelfTailCall(e, node);
+        return;
+    }
+
+    if (node->type == NodeType_FunctionCall)
+    {
+        // a call without a result leaves the result alone.
+        struct FunctionInfo* callee = getCallee(e, node);
+        if (!callee)
+        {
+            return;
+        }
+        if (!e->function)
+        {
+            fprintf(e->out, "%*s", e->indent * 4, "");
+            fprintf(e->out, "if (mt_%s(&result", callee->name);
+            emitArguments(e, node->children[1], false);
+            fprintf(e->out, ")) mtPrint(result);\n");
+            return;
+        }
+
+        line(e, "{");
+        e->indent++;
+        line(e, "struct mtNumber mtValue;");
+        fprintf(e->out, "%*s", e->indent * 4, "");
+        fprintf(e->out, "if (mt_%s(&mtValue", callee->name);
+        emitArguments(e, node->children[1], false);
+        fprintf(e->out, "))\n");
+        line(e, "{");
+        line(e, "    if (hasResult) mtPrint(*result);");
+        line(e, "    *result = mtValue;");
+        line(e, "    hasResult = true;");
+        line(e, "}");
+        e->indent--;
+        line(e, "}");
+        return;
+    }
+
+    if (e->function)
+    {
+        line(e, "if (hasResult) mtPrint(*result);");
+    }
+    fprintf(e->out, "%*s", e->indent * 4, "");
+    fprintf(e->out, e->function ? "*result = " : "mtPrint(");
+    emitExpression(e, node);
+    fprintf(e->out, e->function ? ";\n" : ");\n");
+    if (e->function)
+    {
+        line(e, "hasResult = true;");
+    }
+}
+
+static void emitStatements(struct CEmitter* e, struct ASTNode* block)
+{
+    for (size_t i = 0; i < block->childCount && !e->failed; i++)
+    {
+        struct ASTNode* node = block->children[i];
+        switch (node->type)
+        {
+            case NodeType_Assignment:
+                emitAssignment(e, node);
+                break;
+
+            case NodeType_IfStatement:
+                fprintf(e->out, "%*sif (", e->indent * 4, "");
+                emitCondition(e, node->children[0]);
+                fprintf(e->out, ")\n");
+                emitBlock(e, node->children[1]);
+                break;
+
+            case NodeType_WhileLoop:
+                emitWhileLoop(e, node);
+                break;
+
+            case NodeType_ForLoop:
+                emitForLoop(e, node);
+                break;
+
+            case NodeType_BinaryOperator:
+            case NodeType_FunctionCall:
+            case NodeType_Identifier:
+            case NodeType_Number:
+                emitExpressionStatement(e, node);
+                break;
+
+            // the functions are written before main.
+            default:
+                break;
+        }
+    }
+}
+
+static void emitSignature(struct CEmitter* e, struct FunctionInfo* info, bool value)
+{
+    if (value)
+    {
+        fprintf(e->out, "static inline struct mtNumber mt_%s_value(", info->name);
+    } else {
+        fprintf(e->out, "static bool mt_%s(struct mtNumber* result", info->name);
+    }
+
+    for (size_t i = 0; i < info->parameters.count; i++)
+    {
+        fprintf(e->out, "%sstruct mtNumber* mt_%s", (value && i == 0) ? "" : ", ", info->parameters.names[i]);
+    }
+    if (value && info->parameters.count == 0)
+    {
+        fprintf(e->out, "void");
+    }
+    fprintf(e->out, ")");
+}
+
+static void emitFunction(struct CEmitter* e, struct FunctionInfo* info)
+{
+    e->function = info;
+
+    emitSignature(e, info, false);
+    fprintf(e->out, "\n{\n");
+    e->indent++;
+
+    // a tail call keeps the result from before it, in case the new body has none.
+    line(e, "bool hasResult = false;");
+    line(e, "(void)result;");
+
+    struct ASTNode* tailCall = getTailCall(info->node->children[2]);
+    if (tailCall)
+    {
+        tailCall->isTailCall = true;
+    }
+    if (tailCall && isSelfTailCall(e, tailCall))
+    {
+        if (info->parameters.count > 0)
+        {
+            line(e, "struct mtNumber mtOwned[%zu];", info->parameters.count);
+        }
+        line(e, "mtTailCall:;");
+    }
+
+    fprintf(e->out, "\n");
+
+    // the variables are declared where they're first assigned, like the scopes of the interpreter.
+    pushBlock(e, false);
+    emitStatements(e, info->node->children[2]);
+    popBlock(e);
+
+    fprintf(e->out, "\n");
+    line(e, "return hasResult;");
+    e->indent--;
+    fprintf(e->out, "}\n\n");
+
+    // the same function, for calls that use the result as a value.
+    emitSignature(e, info, true);
+    fprintf(e->out, "\n{\n");
+    e->indent++;
+    line(e, "struct mtNumber result;");
+    fprintf(e->out, "%*sif (!mt_%s(&result", e->indent * 4, "", info->name);
+    for (size_t i = 0; i < info->parameters.count; i++)
+    {
+        fprintf(e->out, ", mt_%s", info->parameters.names[i]);
+    }
+    fprintf(e->out, "))\n");
+    line(e, "{");
+    line(e, "    mtNoResult(\"%s\");", info->name);
+    line(e, "}");
+    line(e, "return result;");
+    e->indent--;
+    fprintf(e->out, "}\n\n");
+
+    e->function = NULL;
+}
+
+int mtEmitC(struct ASTNode* root, FILE* destination)
+{
+    // written to a temporary file first, so nothing is output if it fails halfway.
+    FILE* out = tmpfile();
+    if (!out)
+    {
+        fprintf(stderr, "Can't emit C: failed to create a temporary file.\n");
+        return mtFail;
+    }
+
+    struct CEmitter e;
+    memset(&e, 0, sizeof(e));
+    e.out = out;
+
+    collectTopLevel(&e, root, true);
+    for (size_t i = 0; i < e.functionCount && !e.failed; i++)
+    {
+        collectFunction(&e, &e.functions[i]);
+    }
+
+    if (!e.failed)
+    {
+        fprintf(out, "// Generated by Mint --emit-c\n\n%s\n", preamble);
+
+        for (size_t i = 0; i < e.globals.count; i++)
+        {
+            fprintf(out, "static struct mtNumber mt_%s;\n", e.globals.names[i]);
+        }
+        fprintf(out, "\n");
+
+        for (size_t i = 0; i < e.functionCount; i++)
+        {
+            emitSignature(&e, &e.functions[i], false);
+            fprintf(out, ";\n");
+            emitSignature(&e, &e.functions[i], true);
+            fprintf(out, ";\n");
+        }
+        fprintf(out, "\n");
+
+        for (size_t i = 0; i < e.functionCount && !e.failed; i++)
+        {
+            emitFunction(&e, &e.functions[i]);
+        }
+
+        fprintf(out, "int main(void)\n{\n");
+        e.indent++;
+        line(&e, "struct mtNumber result;");
+        line(&e, "(void)result;");
+        fprintf(out, "\n");
+        pushBlock(&e, true);
+        emitStatements(&e, root);
+        popBlock(&e);
+        fprintf(out, "\n");
+        line(&e, "return 0;");
+        e.indent--;
+        fprintf(out, "}\n");
+    }
+
+    for (size_t i = 0; i < e.functionCount; i++)
+    {
+        free(e.functions[i].name);
+        nameListFree(&e.functions[i].parameters);
+    }
+    free(e.functions);
+    nameListFree(&e.globals);
+    nameListFree(&e.shadowing);
+    nameListFree(&e.counters);
+    while (e.blockCount > 0)
+    {
+        popBlock(&e);
+    }
+    free(e.blocks);
+
+    if (!e.failed)
+    {
+        rewind(out);
+
+        char buffer[4096];
+        size_t count;
+        while ( (count = fread(buffer, 1, sizeof(buffer), out)) > 0 )
+        {
+            fwrite(buffer, 1, count, destination);
+        }
+    }
+    fclose(out);
+
+    return e.failed ? mtFail : mtSuccess;
+}
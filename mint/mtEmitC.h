@@ -0,0 +1,38 @@
+
+#ifndef mtEmitC_h
+#define mtEmitC_h
+
+/*
+*   Translates a program to C, for --emit-c.
+*
+*   Every function becomes a C function and every value a struct mtNumber,
+*   the tagged number the interpreter uses, so the arithmetic is done by the
+*   same code. The output only needs the mtRuntime library:
+*
+*       cc program.c -I include -L path/to/build/objects -lmtRuntime -lm -o program
+*
+*   Variables are looked up statically in C, so programs which depend on
+*   dynamic scoping, a function reading a variable of the function that
+*   called it, can't be translated. Neither can functions defined anywhere
+*   but the top level. Parameters are still passed by reference.
+*
+*   A variable belongs to the block that first assigns it, like in the
+*   interpreter, and becomes a C variable of that block. Programs that read
+*   one after its block ended, or where a loop's variable only exists if an
+*   earlier iteration assigned it, are refused.
+*
+*   A function which only reads its parameters and calls itself in tail 
+*   position jumps back to its start, like the interpreter reuses the frame,
+*   other calls use the C stack.
+*/
+
+#include <stdio.h>
+
+#include "mtAST.h"
+
+//@brief Writes a C translation unit that runs the program in root to out.
+//
+//@returns mtSuccess, or mtFail if the program can't be translated, the reason is printed to stderr.
+int mtEmitC(struct ASTNode* root, FILE* out);
+
+#endif
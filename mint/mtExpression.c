@@ -8,6 +8,7 @@
 #include "mtScope.h"
 
 #include "mtNumberObject.h"
+#include "mtBigInt.h"
 
 #include <Mint.h>
 
@@ -29,14 +30,29 @@ void interpretStatement(struct ASTNode* node, struct mtScope* scope)
 
     if (!left)
     {
-        char nodeStr[node->token.size];
-        mtGetTokenString(leftNode->token, (char*)&nodeStr, mtArraySize(nodeStr));
-
+        // right is probably a temporary, so the variable gets its own copy.
+        mtGCPushTemp(right);
         left = mtCreateObject(right->type);
-        mtHashMapPut(scope->variables, nodeStr, left);
+        mtGCPopTemps(1);
+
+        mtScopeSetObjectN(scope, leftNode->token.string, leftNode->token.size, leftNode->hash, left);
+    }
+    else if (left->isConstant)
+    {
+        // assigning to a literal never changed anything, and its object is shared.
+        return;
+    }
+    else if (left->type == &mtNumberType && right->type == &mtNumberType &&
+             ((struct mtNumber*)left->data)->type != ((struct mtNumber*)right->data)->type)
+    {
+        // a variable holding a different kind of number could break a type hint.
+        if (!mtCheckTypeHints(leftNode, left, right))
+        {
+            return;
+        }
     }
 
-    left->type.set(left->data, right->data);
+    left->type->set(left->data, right->data);
 }
 
 struct mtObject* intepretInteger(struct ASTNode* node)
@@ -44,13 +60,12 @@ struct mtObject* intepretInteger(struct ASTNode* node)
     if (node->token.type == TokenType_IntegerLiteral)
     {
         struct mtObject* out;
-        out = mtCreateObject(mtNumberType);
+        out = mtCreateTempObject(&mtNumberType);
 
         struct mtNumber num;
-        num.type = INTEGER;
-        num.integer = mtInterpretInteger(&node->token);
+        mtInterpretInteger(&node->token, &num);
        
-        out->type.set(out->data, &num);
+        out->type->set(out->data, &num);
 	    return out;
     }
     return NULL;
@@ -60,13 +75,13 @@ struct mtObject* interpretDecimal(struct ASTNode* node)
     if (node->token.type == TokenType_DecimalLiteral)    
     {
         struct mtObject* out;
-        out = mtCreateObject(mtNumberType);
+        out = mtCreateTempObject(&mtNumberType);
 
         struct mtNumber num;
         num.type = DECIMAL;
         num.decimal = mtInterpretDecimal(&node->token);
 
-        out->type.set(out->data, &num);
+        out->type->set(out->data, &num);
 	    return out;
     }
     return NULL;
@@ -79,26 +94,98 @@ struct mtObject* interpretIdentifier(struct ASTNode* node, struct mtScope* scope
     {
         *wasIdentifier = true; 
         struct mtObject* out = NULL;
+
+        if (node->type == NodeType_InlinedParameter)
+        {
+            return mtGetInlinedArgument(node->parameterIndex);
+        }
+
+        // parameters are read straight from the call frame, no lookup needed.
+        struct mtCallFrame* frame = mtGetCurrentFrame();
+        if (node->parameterIndex >= 0 && frame && (size_t)node->parameterIndex < frame->scope.slotCount)
+        {
+            return frame->scope.slots[node->parameterIndex];
+        }
         
-        char str[node->token.size];
-        mtGetTokenString(node->token, (char*)&str, node->token.size); 
-       
-        out = getObjectFromScope(scope, str); 
+        out = getObjectFromScopeN(scope, node->token.string, node->token.size, node->hash);
 
         return out;
     }
     return NULL;
 }
 
+//@brief Sets up node's literal object, if node is a number literal or a constant.
+//
+//@returns false if it isn't, or if its token can't be read as a number.
+static bool makeLiteral(struct ASTNode* node)
+{
+    // checked in the same order as interpretLiterals used to, the token first.
+    struct mtNumber number;
+    if (node->token.type == TokenType_IntegerLiteral)
+    {
+        number.type = INTEGER;
+        int result = mtStringToIntN(&number.integer, node->token.string, node->token.size, 10);
+        if (result == mtStringToIntOverflow || result == mtStringToIntUnderflow)
+        {
+            mtBigIntFromString(&number, node->token.string, node->token.size);
+        }
+        else if (result != mtSuccess)
+        {
+            return false;
+        }
+    } 
+    else if (node->token.type == TokenType_DecimalLiteral)
+    {
+        number.type = DECIMAL;
+        if (mtStringToDoubleN(&number.decimal, node->token.string, node->token.size) != mtSuccess)
+        {
+            return false;
+        }
+    } 
+    else if (node->type == NodeType_Constant)
+    {
+        number = node->constant;
+    } 
+    else 
+    {
+        return false;
+    }
+
+    mtNumberType.set(&node->constant, &number);
+
+    // nothing marks the node, so its big int has to outlive every collection.
+    if (number.type == BIGINT)
+    {
+        mtBigIntKeep(number.big);
+    }
+
+    // it isn't tracked by the garbage collector, it lives as long as the node.
+    struct mtObject* literal = &node->literal;
+    literal->type = &mtNumberType;
+    literal->data = &node->constant;
+    literal->gcNext = NULL;
+    literal->gcMarked = false;
+    literal->temporary = false;
+    literal->isConstant = true;
+    return true;
+}
+
 // doesn't interpret identifiers 
 struct mtObject* interpretLiterals(struct ASTNode* node, struct mtScope* scope)
 {
+    // a literal's value never changes, so it's only read from its token once.
+    if (node->literal.type || makeLiteral(node))
+    {
+        return &node->literal;
+    }
+
 #define Check(out, func)        \
         if ( (out = func) )     \
         {                       \
             return out;         \
         }                        
     
+    // a token that can't be read is read again every time, so it fails with an error every time.
     struct mtObject* out = NULL;
     Check(out, intepretInteger(node));
     Check(out, interpretDecimal(node));
@@ -106,66 +193,185 @@ struct mtObject* interpretLiterals(struct ASTNode* node, struct mtScope* scope)
     return NULL;
 }
 
-struct mtObject* interpretExpression(struct ASTNode* node, struct mtScope* scope)
+//@brief Applies an operator whose operands are known to be ints or decimals, see markOperands in mtFunction.c
+static struct mtObject* interpretTypedOperator(struct ASTNode* node, struct mtScope* scope)
 {
-	if (node == NULL)
+    // the operands can be calls, which allocate, so like in interpretOperator
+    // they have to survive until the result is allocated.
+    struct mtObject* left = interpretExpression(node->children[0], scope);
+    mtGCPushTemp(left);
+    struct mtObject* right = interpretExpression(node->children[1], scope);
+    mtGCPushTemp(right);
+
+    if (!left)
     {
+        interpreterError(node, "Left side of binary operator was NULL!"); 
+        mtGCPopTemps(2);
         return NULL;
-	}
-
-    struct mtObject* out = NULL;
-    if ( (out = interpretLiterals(node, scope)) )
+    }
+    if (!right)
     {
-        return out;
+        interpreterError(node, "Right side of binary operator was NULL!"); 
+        mtGCPopTemps(2);
+        return NULL;
     }
 
-    bool wasFound = 0;
-    out = interpretFunctionCall(node, scope, &wasFound);
-    if (wasFound)
+    struct mtNumber* a = left->data;
+    struct mtNumber* b = right->data;
+
+    struct mtObject* out = mtCreateTempObject(&mtNumberType);
+    mtGCPopTemps(2);
+    struct mtNumber* number = out->data;
+
+    if (node->token.type == TokenType_OperatorDivision)
     {
+        numberDiv(number, a, b);
         return out;
     }
-    out = interpretIdentifier(node, scope, &wasFound);
-    if (wasFound)    
+
+    if (node->operands == Operands_Integer)
     {
-        return out;
-    }
+        // big ints, and the results which don't fit in an int64_t, go through the number's own operators.
+        int64_t result = 0;
+        bool overflowed = a->type != INTEGER || b->type != INTEGER;
+        switch (node->token.type)
+        {
+            case TokenType_OperatorAddition:
+                overflowed = overflowed || __builtin_add_overflow(a->integer, b->integer, &result);
+                if (overflowed)
+                {
+                    numberAdd(number, a, b);
+                }
+                break;
+            case TokenType_OperatorSubtraction:
+                overflowed = overflowed || __builtin_sub_overflow(a->integer, b->integer, &result);
+                if (overflowed)
+                {
+                    numberSub(number, a, b);
+                }
+                break;
+            case TokenType_OperatorMultiplication:
+                overflowed = overflowed || __builtin_mul_overflow(a->integer, b->integer, &result);
+                if (overflowed)
+                {
+                    numberMul(number, a, b);
+                }
+                break;
+            default:
+                break;
+        }
 
+        if (!overflowed)
+        {
+            number->type = INTEGER;
+            number->integer = result;
+        }
+    } else {
+        number->type = DECIMAL;
+        switch (node->token.type)
+        {
+            case TokenType_OperatorAddition:
+                number->decimal = a->decimal + b->decimal;
+                break;
+            case TokenType_OperatorSubtraction:
+                number->decimal = a->decimal - b->decimal;
+                break;
+            case TokenType_OperatorMultiplication:
+                number->decimal = a->decimal * b->decimal;
+                break;
+            default:
+                break;
+        }
+    }
+    return out;
+}
 
+//@brief Applies a binary operator through the operands' type.
+static struct mtObject* interpretOperator(struct ASTNode* node, struct mtScope* scope)
+{
+    // the operands have to survive until the result is allocated.
     struct mtObject* left = interpretExpression(node->children[0], scope);
+    mtGCPushTemp(left);
     struct mtObject* right = interpretExpression(node->children[1], scope);
+    mtGCPushTemp(right);
 
     if (!left)
     {
         interpreterError(node, "Left side of binary operator was NULL!"); 
+        mtGCPopTemps(2);
         return NULL;
     }
     if (!right)
     {
         interpreterError(node, "Right side of binary operator was NULL!"); 
+        mtGCPopTemps(2);
         return NULL;
     }
 
-    out = NULL;
-    out = mtCreateObject(left->type);
+    struct mtObject* out = mtCreateTempObject(left->type);
     switch (node->token.type)
     {
         case TokenType_OperatorAddition:
-            out->data = left->type.add(left->data, right->data); 
+            left->type->add(out->data, left->data, right->data); 
             break;
         case TokenType_OperatorSubtraction:
-            out->data = left->type.sub(left->data, right->data);
+            left->type->sub(out->data, left->data, right->data);
             break;
         case TokenType_OperatorMultiplication:
-            out->data = left->type.mul(left->data, right->data);
+            left->type->mul(out->data, left->data, right->data);
             break;
         case TokenType_OperatorDivision:
-            out->data = left->type.div(left->data, right->data);
+            left->type->div(out->data, left->data, right->data);
             break;
         default:
             break;
     }
+    mtGCPopTemps(2);
+
+    return out;
+}
+
+struct mtObject* interpretExpression(struct ASTNode* node, struct mtScope* scope)
+{
+	if (node == NULL)
+    {
+        return NULL;
+	}
+
+    struct mtObject* out = NULL;
+    if ( (out = interpretLiterals(node, scope)) )
+    {
+        return out;
+    }
 
+    bool wasFound = 0;
+    out = interpretFunctionCall(node, scope, &wasFound);
+    if (wasFound)
+    {
+        return out;
+    }
+    out = interpretIdentifier(node, scope, &wasFound);
+    if (wasFound)    
+    {
+        return out;
+    }
+
+    // an earlier node in the same statement computed this already, see mtOptimize.h
+    if (node->sameAs)
+    {
+        return node->sameAs->lastResult;
+    }
 
+    if (node->operands != Operands_Unknown)
+    {
+        out = interpretTypedOperator(node, scope);
+    } else {
+        out = interpretOperator(node, scope);
+    }
+
+    if (node->keepsResult)
+    {
+        node->lastResult = out;
+    }
     return out;
 }
@@ -1,23 +1,350 @@
 
 #include "mtFunction.h"
 #include <stdarg.h>
+#include <stddef.h> // for max_align_t
 
 #include "mtBlock.h"
 #include "mtExpression.h"
+#include "mtInfer.h"
+#include "mtInterpreter.h"
+#include "mtInterpreterError.h"
 
-static void interpreterError(struct ASTNode* node, const char* fmt, ...)
+static struct mtCallFrame* currentFrame = NULL;
+
+// the frames and their arguments live here instead of on the C stack,
+// a returning call gives its memory back to the next one.
+static struct mtArena frameStack;
+
+// the arguments of the innermost inlined call that is being evaluated, see mtInline.h
+static struct mtObject** inlinedArguments = NULL;
+
+static size_t maxCallDepth = 0; // 0 for mtDefaultMaxCallDepth
+static bool memoization = false;
+static bool jit = false;
+
+struct mtCallFrame* mtGetCurrentFrame()
+{
+    return currentFrame;
+}
+
+struct mtObject* mtGetInlinedArgument(size_t index)
+{
+    return inlinedArguments ? inlinedArguments[index] : NULL;
+}
+
+void mtSetMaxCallDepth(size_t depth)
+{
+    maxCallDepth = depth;
+}
+
+size_t mtGetMaxCallDepth()
+{
+    return maxCallDepth ? maxCallDepth : mtDefaultMaxCallDepth;
+}
+
+void mtSetMemoization(bool enabled)
+{
+    memoization = enabled;
+}
+
+void mtSetJit(bool enabled)
+{
+    jit = enabled;
+}
+
+// the result of checking part of a function body.
+enum Purity {
+    Purity_Pure,
+    Purity_Impure,
+    Purity_Assumed // pure, if the functions that are still being checked turn out to be pure
+};
+
+static enum Purity checkFunctionPurity(struct mtFunction* func, struct mtScope* scope);
+
+//@brief Checks whether node only reads parameters and calls pure functions,
+// the functions it calls are looked up in scope.
+static enum Purity checkPurity(struct ASTNode* node, struct mtScope* scope)
+{
+    if (node == NULL)
+    {
+        return Purity_Pure;
+    }
+
+    enum Purity out = Purity_Pure;
+    switch (node->type)
+    {
+        case NodeType_Number:
+        case NodeType_Constant:
+            return Purity_Pure;
+        case NodeType_Identifier:
+            // anything else is a variable of one of the callers.
+            return node->parameterIndex >= 0 ? Purity_Pure : Purity_Impure;
+
+        case NodeType_FunctionCall:
+        {
+            struct ASTNode* identifier = node->children[0];
+            struct mtFunction* callee = getFunctionFromScopeN(scope, identifier->token.string, 
+                                                              identifier->token.size, identifier->hash);
+            if (!callee)
+            {
+                return Purity_Impure;
+            }
+            out = checkFunctionPurity(callee, scope);
+            if (out == Purity_Impure)
+            {
+                return out;
+            }
+
+            // only the arguments are left, not the identifier.
+            enum Purity arguments = checkPurity(node->children[1], scope);
+            return arguments == Purity_Pure ? out : arguments;
+        }
+
+        case NodeType_BinaryOperator:
+        case NodeType_Block:
+        case NodeType_IfStatement:
+        case NodeType_ArgumentList:
+        case NodeType_GreaterThan:
+        case NodeType_LesserThan:
+        case NodeType_GreaterThanOrEqual:
+        case NodeType_LesserThanOrEqual:
+        case NodeType_IsEqual:
+        case NodeType_IsNotEqual:
+            break;
+
+        // assignments write to the callers' variables, definitions to the scope.
+        default:
+            return Purity_Impure;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        enum Purity child = checkPurity(node->children[i], scope);
+        if (child == Purity_Impure)
+        {
+            return child;
+        }
+        if (child == Purity_Assumed)
+        {
+            out = child;
+        }
+    }
+    return out;
+}
+
+static enum Purity checkFunctionPurity(struct mtFunction* func, struct mtScope* scope)
+{
+    size_t epoch = mtScopeGetFunctionEpoch();
+    if (func->purityEpoch != epoch)
+    {
+        func->purity = mtPurityUnknown;
+        func->purityEpoch = epoch;
+        mtMemoClear(&func->memo);
+    }
+
+    switch (func->purity)
+    {
+        case mtPure:
+            return Purity_Pure;
+        case mtImpure:
+            return Purity_Impure;
+        case mtPurityChecking:
+            // a recursive call, it's pure if the rest of the function is.
+            return Purity_Assumed;
+        default:
+            break;
+    }
+
+    func->purity = mtPurityChecking;
+    enum Purity out = checkPurity(func->block, scope);
+
+    if (out == Purity_Assumed)
+    {
+        // it depends on a function further up that isn't done yet, 
+        // it'll be checked again once that one is.
+        func->purity = mtPurityUnknown;
+    } else {
+        func->purity = out == Purity_Pure ? mtPure : mtImpure;
+    }
+    return out;
+}
+
+//@returns true if calls to func from scope can be answered from its cache.
+static bool isPure(struct mtFunction* func, struct mtScope* scope)
+{
+    enum Purity purity = checkFunctionPurity(func, scope);
+
+    // nothing above func was being checked, so the only assumption was about func itself.
+    if (purity == Purity_Assumed)
+    {
+        func->purity = mtPure;
+        return true;
+    }
+    return purity == Purity_Pure;
+}
+
+static bool fitsTypeHint(const struct Parameter* parameter, struct mtObject* value)
+{
+    if (!parameter->type)
+    {
+        return true;
+    }
+    if (value->type != parameter->type)
+    {
+        return false;
+    }
+    // a big int is an int as far as hints go.
+    return parameter->type != &mtNumberType || 
+           (mtNumberIsInteger(value->data) ? INTEGER : DECIMAL) == parameter->numberType;
+}
+
+static bool checkArguments(struct ASTNode* node, struct mtFunction* func, struct mtObject** arguments)
+{
+    for (size_t i = 0; i < func->parameterCount; i++)
+    {
+        if (!fitsTypeHint(&func->parameters[i], arguments[i]))
+        {
+            interpreterError(node, "\"%s\" expects %s to be %s!", 
+                             func->identifier, func->parameters[i].identifier, func->parameters[i].typeName);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mtCheckTypeHints(struct ASTNode* node, struct mtObject* variable, struct mtObject* value)
 {
-    va_list args;
-    va_start(args, fmt);
-    fprintf(stderr, "Error while interpreting on line %d: \n\t", 
-            node->token.line 
-    );
-    vfprintf(stderr, fmt, args);
+    for (struct mtCallFrame* frame = currentFrame; frame; frame = frame->caller)
+    {
+        struct mtFunction* func = frame->function;
+        if (!func->hasTypeHints)
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < frame->scope.slotCount; i++)
+        {
+            if (frame->scope.slots[i] == variable && !fitsTypeHint(&func->parameters[i], value))
+            {
+                interpreterError(node, "%s has to stay %s, it's a parameter of \"%s\"!", 
+                                 func->parameters[i].identifier, func->parameters[i].typeName, func->identifier);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//@brief Checks if func can be run in frame, instead of getting a frame of its own.
+//
+// The frame's scope is still below the scope of the call that made it, so the variables
+// of the function that makes the tail call can't be seen from it anymore. func may only 
+// read its own parameters, and call functions that do the same, see isPure.
+static bool canReuseFrame(struct mtCallFrame* frame, struct mtFunction* func, 
+                          struct mtObject** arguments, struct mtScope* scope)
+{
+    if (!frame->ownedArguments || func->parameterCount > frame->capacity || !isPure(func, scope))
+    {
+        return false;
+    }
 
-    if (fmt[strlen(fmt)] != '\n')
+    // temporaries are copied into the owned arguments, so the types have to match.
+    for (size_t i = 0; i < func->parameterCount; i++)
     {
-        printf("\n");
+        if (arguments[i]->temporary && arguments[i]->type != frame->ownedArguments[i]->type)
+        {
+            return false;
+        }
     }
+    return true;
+}
+
+//@brief Sets frame up to run func with arguments once its current body has unwound.
+static void reuseFrame(struct mtCallFrame* frame, struct mtFunction* func, struct mtObject** arguments)
+{
+    size_t count = func->parameterCount;
+
+    // the new arguments could be made from the old ones, e.g. f(b, a),
+    // so all of them are copied out before any of them are overwritten.
+    size_t offsets[count + 1];
+    size_t stagingSize = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        offsets[i] = stagingSize;
+        if (arguments[i]->temporary)
+        {
+            stagingSize += arguments[i]->type->size / sizeof(max_align_t) + 1;
+        }
+    }
+
+    max_align_t staging[stagingSize + 1];
+    for (size_t i = 0; i < count; i++)
+    {
+        if (arguments[i]->temporary)
+        {
+            arguments[i]->type->set(&staging[offsets[i]], arguments[i]->data);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // variables are still passed by reference, like in any other call.
+        if (!arguments[i]->temporary)
+        {
+            frame->scope.slots[i] = arguments[i];
+            continue;
+        }
+
+        struct mtObject* owned = frame->ownedArguments[i];
+        owned->type->set(owned->data, &staging[offsets[i]]);
+        frame->scope.slots[i] = owned;
+    }
+
+    frame->function = func;
+    frame->scope.slotNames = func->parameterNames;
+    frame->scope.slotCount = count;
+    frame->tailCall = true;
+}
+
+//@brief Evaluates the copy of func's body in node instead of calling it, see mtInline.h
+static struct mtObject* interpretInlinedCall(struct ASTNode* node, struct mtFunction* func, struct mtScope* scope)
+{
+    struct ASTNode* argumentList = node->children[1];
+    size_t count = func->parameterCount;
+
+    struct mtObject* arguments[count + 1];
+    for (size_t i = 0; i < count; i++)
+    {
+        arguments[i] = interpretExpression(argumentList->children[i], scope);
+        mtGCPushTemp(arguments[i]);
+        if (!arguments[i])
+        {
+            mtGCPopTemps(i + 1);
+            return NULL;
+        }
+    }
+
+    if (func->hasTypeHints && !checkArguments(node, func, arguments))
+    {
+        mtGCPopTemps(count);
+        return NULL;
+    }
+
+    struct mtObject** outer = inlinedArguments;
+    inlinedArguments = arguments;
+    struct mtObject* result = interpretExpression(node->children[2], scope);
+    inlinedArguments = outer;
+
+    // a call's result is a copy, not one of the variables it read.
+    if (result && !result->temporary)
+    {
+        struct mtObject* copy = mtCreateTempObject(result->type);
+        copy->type->set(copy->data, result->data);
+        result = copy;
+    }
+
+    mtGCPopTemps(count);
+    return result;
 }
 
 struct mtObject* interpretFunctionCall(struct ASTNode* node, struct mtScope* scope, bool* wasFunc)
@@ -32,9 +359,17 @@ struct mtObject* interpretFunctionCall(struct ASTNode* node, struct mtScope* sco
     struct Token identifier = node->children[0]->token; 
     struct ASTNode* argumentList = node->children[1];
 
-    char tokenStr[identifier.size];
-    mtGetTokenString(identifier, (char*)&tokenStr, identifier.size);
-    struct mtFunction* func = getFunctionFromScope(scope, tokenStr);
+    struct mtFunction* func = NULL;
+    size_t epoch = mtScopeGetFunctionEpoch();
+    if (node->cachedFunction && node->cachedEpoch == epoch)
+    {
+        func = node->cachedFunction;
+    } else {
+        func = getFunctionFromScopeN(scope, identifier.string, identifier.size, node->children[0]->hash);
+
+        node->cachedFunction = func;
+        node->cachedEpoch = epoch;
+    }
 
     if (!func)
     {
@@ -42,83 +377,459 @@ struct mtObject* interpretFunctionCall(struct ASTNode* node, struct mtScope* sco
         return NULL;
     }
 
+    // the name could mean another function by now, then it's called like any other.
+    if (node->inlined && func->block == node->inlined->children[2])
+    {
+        return interpretInlinedCall(node, func, scope);
+    }
+
     if (argumentList->childCount != func->parameterCount)   
     {
         if (argumentList->childCount > func->parameterCount)
         {
             interpreterError(node, 
                              "Too many arguments to function \"%s\", expected %d arguments!", 
-                             tokenStr, func->parameterCount);
+                             func->identifier, func->parameterCount);
         }
         if (argumentList->childCount < func->parameterCount)
         {
             interpreterError(node, 
                              "Too few arguments to function \"%s\", expected %d arguments!", 
-                             tokenStr, func->parameterCount);
+                             func->identifier, func->parameterCount);
         }
         return NULL;
     }
 
-    struct mtScope* arguments = mtCreateScope();
-    arguments->parent = scope; 
+    size_t count = func->parameterCount;
+
+    // the frame and both of its argument arrays are allocated together.
+    struct mtArenaMark frameMark = mtArenaGetMark(&frameStack);
+    struct mtCallFrame* frame = mtArenaAlloc(&frameStack, 
+            sizeof(struct mtCallFrame) + sizeof(struct mtObject*) * count * 2);
+    struct mtObject** arguments = (struct mtObject**)(frame + 1);
+    struct mtObject** ownedArguments = arguments + count;
 
-    for (size_t i = 0; i < argumentList->childCount; i++)
+    for (size_t i = 0; i < count; i++)
     {
         struct mtObject* argument = interpretExpression(argumentList->children[i], scope);
 
+        // parameters are passed by reference, a literal's object is shared so the call gets a copy.
+        if (argument && argument->isConstant)
+        {
+            struct mtObject* copy = mtCreateTempObject(argument->type);
+            copy->type->set(copy->data, argument->data);
+            argument = copy;
+        }
+
+        // keeps the arguments that were already evaluated alive.
+        mtGCPushTemp(argument);
         if (!argument)
+        {
+            mtGCPopTemps(i + 1);
+            mtArenaReset(&frameStack, frameMark);
             return NULL;
-        mtHashMapPut(arguments->variables, func->parameters[i].identifier, argument);   
+        }
+        arguments[i] = argument;
+    }
+
+    if (func->hasTypeHints && !checkArguments(node, func, arguments))
+    {
+        mtGCPopTemps(count);
+        mtArenaReset(&frameStack, frameMark);
+        return NULL;
+    }
+
+    // the key is taken now, a tail call could overwrite the arguments.
+    bool memoize = memoization && isPure(func, scope) && mtMemoCanKey(arguments, count);
+    size_t keySize = memoize ? mtMemoKeySize(arguments, count) : 0;
+    char keyBuffer[keySize + 1];
+    struct mtMemoKey key;
+
+    if (memoize)
+    {
+        mtMemoMakeKey(&key, (char*)&keyBuffer, arguments, count);
+
+        struct mtObject* cached = mtMemoLookup(&func->memo, &key);
+        if (cached)
+        {
+            mtGCPopTemps(count);
+            mtArenaReset(&frameStack, frameMark);
+            return cached;
+        }
+    }
+
+    struct mtCallFrame* caller = currentFrame;
+    size_t maxDepth = mtGetMaxCallDepth();
+    if (jit)
+    {
+        struct mtObject* compiled = NULL;
+        if (mtJitRun(func, arguments, scope, caller ? caller->depth : 0, maxDepth, &compiled))
+        {
+            if (memoize && compiled)
+            {
+                mtMemoStore(&func->memo, &key, compiled);
+            }
+            mtGCPopTemps(count);
+            mtArenaReset(&frameStack, frameMark);
+            return compiled;
+        }
+    }
+
+    if (node->isTailCall && caller && canReuseFrame(caller, func, arguments, scope))
+    {
+        reuseFrame(caller, func, arguments);
+        mtGCPopTemps(count);
+        mtArenaReset(&frameStack, frameMark);
+        return NULL;
+    }
+
+    frame->depth = caller ? caller->depth + 1 : 1;
+    if (frame->depth > maxDepth || mtIsCStackExhausted())
+    {
+        if (frame->depth > maxDepth)
+        {
+            interpreterError(node, "Maximum call depth of %zu exceeded in \"%s\", see --max-depth", 
+                             maxDepth, func->identifier);
+        } else {
+            interpreterError(node, "Ran out of stack after %zu nested calls in \"%s\"", 
+                             frame->depth, func->identifier);
+        }
+        mtHalt();
+
+        mtGCPopTemps(count);
+        mtArenaReset(&frameStack, frameMark);
+        return NULL;
     }
-   
-    interpretBlock(func->block, arguments);
 
-    return NULL;
+    frame->function = func;
+    frame->caller = caller;
+    frame->ownedArguments = NULL;
+    frame->capacity = count;
+    frame->tailCall = false;
+    frame->result = NULL;
+
+    mtInitScope(&frame->scope, scope);
+    frame->scope.slots = arguments;
+    frame->scope.slotNames = func->parameterNames;
+    frame->scope.slotCount = count;
+
+    mtGCPushScope(&frame->scope);
+    mtGCPopTemps(count);
+
+    if (func->hasTailCalls)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            ownedArguments[i] = mtCreateTempObject(arguments[i]->type);
+        }
+        frame->ownedArguments = ownedArguments;
+    }
+
+    // tail calls unwind back to here, everything after this mark belongs to the body.
+    struct mtArenaMark base = mtTempMark();
+    size_t printed = mtGetPrintedResults();
+
+    currentFrame = frame;
+    interpretBlock(func->block, &frame->scope);
+    while (frame->tailCall && !mtIsHalted())
+    {
+        frame->tailCall = false;
+
+        // the result from before the tail call is still the call's if the new body has none.
+        frame->result = mtTempReleaseKeeping(base, frame->result);
+
+        interpretBlock(frame->function->block, &frame->scope);
+    }
+    currentFrame = caller;
+    struct mtObject* result = frame->result;
+
+    mtGCPopScope();
+    mtReleaseScope(&frame->scope, NULL);
+    mtArenaReset(&frameStack, frameMark);
+
+    if (memoize && result && !mtIsHalted() && mtGetPrintedResults() == printed)
+    {
+        mtMemoStore(&func->memo, &key, result);
+    }
+
+    return result;
 }
 
-void interpretFunctionDef(struct ASTNode* node, struct mtScope* scope)
+static bool tokenEquals(struct Token a, struct Token b)
 {
-    // children of the function_def node:
-    // 1st      child: identifier
-    // 2nd      child: parameterList 
-    // 3rd      child: block
-    //
-    // children of the parameterList node:
-    // 1...nth  child: parameter
-    if (node->type != NodeType_FunctionDefinition)
+    return a.size == b.size && memcmp(a.string, b.string, a.size) == 0;
+}
+
+//@brief Gives every identifier in node which names a parameter that parameter's index.
+// Nested function definitions are skipped, they're resolved against their own parameters.
+static void resolveParameters(struct ASTNode* node, struct ASTNode* parameterList)
+{
+    if (node == NULL || node->type == NodeType_FunctionDefinition)
     {
         return;
     }
 
-    struct mtFunction* out = malloc(sizeof(struct mtFunction));
+    // a loop counter with a parameter's name hides the parameter in the loop's body,
+    // the counter is only found by name, so nothing in the loop is resolved.
+    if (node->type == NodeType_ForLoop)
+    {
+        for (size_t i = 0; i < parameterList->childCount; i++)
+        {
+            if (tokenEquals(node->children[0]->token, parameterList->children[i]->token))
+            {
+                resolveParameters(node->children[1], parameterList);
+                resolveParameters(node->children[2], parameterList);
+                return;
+            }
+        }
+    }
+
+    if (node->type == NodeType_Identifier)
+    {
+        node->parameterIndex = -1;
+        for (size_t i = 0; i < parameterList->childCount; i++)
+        {
+            if (tokenEquals(node->token, parameterList->children[i]->token))
+            {
+                node->parameterIndex = i;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        resolveParameters(node->children[i], parameterList);
+    }
+}
+
+//@brief Marks the calls in block whose result would be the function's result,
+// the last statement, or the last statement of an if statement that is the last statement.
+//
+//@returns true if any calls were marked.
+static bool markTailCalls(struct ASTNode* block)
+{
+    if (block == NULL || block->childCount == 0)
+    {
+        return false;
+    }
+
+    struct ASTNode* last = block->children[block->childCount - 1];
+    if (last->type == NodeType_FunctionCall)
+    {
+        last->isTailCall = true;
+        return true;
+    }
+    if (last->type == NodeType_IfStatement && last->childCount > 1)
+    {
+        return markTailCalls(last->children[1]);
+    }
+
+    return false;
+}
+
+static const struct {
+    const char* name;
+    int numberType;
+} typeHints[] = {
+    { "int", INTEGER },
+    { "dec", DECIMAL }
+};
+
+bool mtResolveTypeHint(struct Parameter* parameter, struct ASTNode* hint)
+{
+    for (size_t i = 0; i < mtArraySize(typeHints); i++)
+    {
+        if (tokenEquals(hint->token, mtCreateStringToken(typeHints[i].name)))
+        {
+            parameter->type = &mtNumberType;
+            parameter->numberType = typeHints[i].numberType;
+            parameter->typeName = typeHints[i].name;
+            return true;
+        }
+    }
+    return false;
+}
+
+//@brief Marks the operators in node whose operands are both ints or both decimals.
+// The type hints are checked on every call and assignment, so they're known 
+// more precisely than what mtInferTypes could tell from the parameters' names.
+//
+//@returns what node's value is known to be.
+static enum mtInferredType markOperands(struct ASTNode* node, struct mtFunction* func)
+{
+    if (node == NULL || node->type == NodeType_FunctionDefinition)
+    {
+        return Inferred_None;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Identifier:
+        {
+            if (node->parameterIndex < 0 || !func->parameters[node->parameterIndex].type)
+            {
+                return node->inferred;
+            }
+            return func->parameters[node->parameterIndex].numberType == INTEGER ? 
+                   Inferred_Integer : Inferred_Decimal;
+        }
+
+        case NodeType_BinaryOperator:
+        case NodeType_GreaterThan:
+        case NodeType_LesserThan:
+        case NodeType_GreaterThanOrEqual:
+        case NodeType_LesserThanOrEqual:
+        case NodeType_IsEqual:
+        case NodeType_IsNotEqual:
+        {
+            if (node->childCount < 2)
+            {
+                break;
+            }
+
+            enum mtInferredType left = markOperands(node->children[0], func);
+            enum mtInferredType right = markOperands(node->children[1], func);
+            if (left == right && (left == Inferred_Integer || left == Inferred_Decimal))
+            {
+                node->operands = left == Inferred_Integer ? Operands_Integer : Operands_Decimal;
+            }
+
+            if (node->type != NodeType_BinaryOperator)
+            {
+                return Inferred_None;
+            }
+            return mtInferArithmetic(node->token.type, left, right);
+        }
+
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        markOperands(node->children[i], func);
+    }
+    return node->inferred;
+}
 
+//@brief Builds the function node defines, its parameters are resolved here once
+// and every later execution of the definition reuses it.
+static struct mtFunction* compileFunction(struct ASTNode* node)
+{
     struct Token identifier = node->children[0]->token;
     if (identifier.type != TokenType_Identifier)
     {
-        return;
+        return NULL;
     }
-    char tokenStr[identifier.size];
-    mtGetTokenString(identifier, (char*)&tokenStr, identifier.size);
-    out->identifier = strndup(tokenStr, identifier.size);
+
+    struct mtFunction* out = malloc(sizeof(struct mtFunction));
+    out->identifier = strndup(identifier.string, identifier.size);
     
     struct ASTNode* parameterList = node->children[1];
 
     out->parameterCount = parameterList->childCount;
     out->parameters = malloc(sizeof(struct Parameter) * out->parameterCount);
+    out->parameterNames = malloc(sizeof(const char*) * out->parameterCount);
     
+    out->hasTypeHints = false;
     for (size_t i = 0; i < out->parameterCount; i++)
     {
-        struct ASTNode* parameterNode = parameterList->children[i];         
+        struct Token parameter = parameterList->children[i]->token;         
        
-        size_t tokenSize = parameterNode->token.size;
-        char tokenStr[parameterNode->token.size];
-
-        mtGetTokenString(parameterNode->token, (char*) &tokenStr, tokenSize);
-        out->parameters[i].identifier = strndup(tokenStr, tokenSize); 
+        out->parameters[i].identifier = strndup(parameter.string, parameter.size); 
         out->parameters[i].type = NULL;
+        out->parameters[i].typeName = NULL;
+        out->parameterNames[i] = out->parameters[i].identifier;
+
+        if (parameterList->children[i]->childCount == 0)
+        {
+            continue;
+        }
+        struct ASTNode* hint = parameterList->children[i]->children[0];
+        if (!mtResolveTypeHint(&out->parameters[i], hint))
+        {
+            char hintStr[hint->token.size + 1];
+            mtGetTokenString(hint->token, (char*)&hintStr, hint->token.size);
+            interpreterError(hint, "Unknown type \"%s\", expected int or dec!", hintStr);
+        }
+        out->hasTypeHints = out->hasTypeHints || out->parameters[i].type;
     }
     struct ASTNode* block = node->children[2];
     out->block = block; 
 
-    mtHashMapPut(scope->functions, out->identifier, out);
+    resolveParameters(block, parameterList);
+    out->hasTailCalls = markTailCalls(block);
+    if (out->hasTypeHints)
+    {
+        markOperands(block, out);
+    }
+
+    out->purity = mtPurityUnknown;
+    out->purityEpoch = 0;
+    out->memo.entries = NULL;
+    mtJitInit(&out->jit);
+
+    return out;
+}
+
+void interpretFunctionDef(struct ASTNode* node, struct mtScope* scope)
+{
+    // children of the function_def node:
+    // 1st      child: identifier
+    // 2nd      child: parameterList 
+    // 3rd      child: block
+    //
+    // children of the parameterList node:
+    // 1...nth  child: parameter
+    if (node->type != NodeType_FunctionDefinition)
+    {
+        return;
+    }
+
+    if (!node->prototype)
+    {
+        node->prototype = compileFunction(node);
+    }
+    if (!node->prototype)
+    {
+        return;
+    }
+
+    mtScopeSetFunction(scope, node->prototype->identifier, node->prototype);
+}
+
+void mtFreePrototypes(struct ASTNode* node)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    mtFreeFunction(node->prototype);
+    node->prototype = NULL;
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        mtFreePrototypes(node->children[i]);
+    }
+}
+
+void mtFreeFunction(void* function)
+{
+    struct mtFunction* func = function;
+    if (!func)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < func->parameterCount; i++)
+    {
+        free((void*)func->parameters[i].identifier);
+    }
+    free(func->parameters);
+    free(func->parameterNames);
+    mtMemoClear(&func->memo);
+    free((void*)func->identifier);
+    free(func);
 }
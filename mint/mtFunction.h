@@ -6,10 +6,26 @@
 
 #include "mtScope.h"
 #include "mtAST.h"
+#include "mtMemo.h"
+#include "mtJit.h"
 
+// the C stack a nested call is given, the frame itself is on a stack of its own but the interpreter
+// still recurses through interpretFunctionCall and interpretBlock. f(n - 1) + 1 nested in an if
+// and an assignment measured about 1.1KB, nested in a while, an if and a for about 1.7KB,
+// calls nested deeper take more. mtInterpret sizes the C stack by this and the depth limit.
+#define mtCallCStackCost 4096
+
+// how many calls can be nested unless --max-depth says otherwise.
+#define mtDefaultMaxCallDepth 100000
+
+// parameters can have a type hint, ex: func f(x: int, y: dec)
 struct Parameter {
     const char* identifier;
-    struct Type* type; // could be NULL
+    const struct Type* type; // NULL if it has no type hint
+
+    // for numbers, the kind of number it has to be, INTEGER or DECIMAL
+    int numberType;
+    const char* typeName;
 };
 
 struct mtFunction {
@@ -19,9 +35,89 @@ struct mtFunction {
     
     size_t parameterCount; 
     struct Parameter* parameters;
+    const char** parameterNames; // the parameters' identifiers again, for the call frame's scope
+
+    bool hasTailCalls;
+    bool hasTypeHints; // the arguments are checked against them on every call
+
+    // A pure function only reads its parameters and calls other pure functions,
+    // so its result only depends on its arguments and can be cached.
+    // Which function a call reaches can change, so it's checked again
+    // whenever the function epoch changes, see mtScopeGetFunctionEpoch.
+    enum {
+        mtPurityUnknown,
+        mtPurityChecking,
+        mtPure,
+        mtImpure
+    } purity;
+    size_t purityEpoch;
+
+    struct mtMemoTable memo; // only used if memoization is enabled
+    struct mtJitCode jit; // only used if the JIT is enabled
+};
+
+// a function call that is in progress, they're kept on a stack of their own.
+struct mtCallFrame {
+    struct mtFunction* function;
+    struct mtCallFrame* caller; // NULL if called from the top level
+    size_t depth; // 1 for calls from the top level
+
+    // the arguments, by parameter index. 
+    // identifiers resolved to a parameter index read them straight from scope.slots,
+    // everything else, like functions called from this one, finds them by name.
+    struct mtScope scope;
+
+    // A call in tail position reuses its caller's frame, its body unwinds and the
+    // frame's function is run again with the new arguments instead of recursing.
+    // Temporary arguments are copied into ownedArguments so they outlive the
+    // statement that made them, it's NULL if the function makes no tail calls.
+    struct mtObject** ownedArguments;
+    size_t capacity; // of scope.slots and ownedArguments
+    bool tailCall;
+
+    // the last expression statement's result, a temporary object. It's the call's result
+    // unless another one comes after it, then it's printed instead, see interpretStatements.
+    struct mtObject* result;
 };
 
+//@returns the frame of the innermost function call, or NULL at the top level.
+struct mtCallFrame* mtGetCurrentFrame();
+
+//@returns an argument of the innermost inlined call, see mtInline.h
+struct mtObject* mtGetInlinedArgument(size_t index);
+
+//@brief Sets how many calls can be nested before the interpreter stops with an error.
+//
+//@param depth 0 for mtDefaultMaxCallDepth, that's the default.
+void mtSetMaxCallDepth(size_t depth);
+size_t mtGetMaxCallDepth();
+
+//@brief Enables caching the results of pure functions, off by default.
+void mtSetMemoization(bool enabled);
+
+//@brief Enables compiling hot functions to machine code, off by default, see mtJit.h
+void mtSetJit(bool enabled);
+
+//@returns the result of the call, the last expression statement its body ran, or NULL.
 struct mtObject* interpretFunctionCall(struct ASTNode* node, struct mtScope* scope, bool* wasFunc);
 void interpretFunctionDef(struct ASTNode* node, struct mtScope* scope);
 
+//@brief Checks that setting variable to value doesn't break the type hint of a call in progress,
+// variable could be one of its arguments under any name, they're passed by reference.
+//
+//@returns false, after printing an error, if it would.
+bool mtCheckTypeHints(struct ASTNode* node, struct mtObject* variable, struct mtObject* value);
+
+//@brief Sets parameter's type to the one hint names, ex: the int in func f(x: int)
+//
+//@returns false if there's no such type.
+bool mtResolveTypeHint(struct Parameter* parameter, struct ASTNode* hint);
+
+//@brief Frees an mtFunction.
+void mtFreeFunction(void* function);
+
+//@brief Frees the functions compiled from the definitions in node and its children,
+// has to be called before the AST is freed.
+void mtFreePrototypes(struct ASTNode* node);
+
 #endif
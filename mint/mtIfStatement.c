@@ -1,13 +1,14 @@
 #include "mtIfStatement.h"
 #include "mtAST.h"
 #include "mtObject.h"
+#include "mtNumberObject.h"
 #include "mtUtilities.h"
 #include "mtExpression.h"
 #include "mtBlock.h"
 
 #include "mtInterpreterError.h"
 
-void interpretIfStatement(struct ASTNode* node, struct mtScope* scope)
+struct mtObject* interpretIfStatement(struct ASTNode* node, struct mtScope* scope)
 {
 
     bool conditional = false;
@@ -17,12 +18,42 @@ void interpretIfStatement(struct ASTNode* node, struct mtScope* scope)
     if (result != mtSuccess)
     {
         interpreterError(node, "Could not interpret conditional!");
-        return;
+        return NULL;
     }
     
     if (conditional)
     {
-        interpretBlock(node->children[1], scope);
+        return interpretBlock(node->children[1], scope);
+    }
+    return NULL;
+}
+
+//@brief Compares two numbers that are known to be ints, or decimals if isDecimal.
+static bool compareTyped(enum NodeType comparison, struct mtNumber* a, struct mtNumber* b, bool isDecimal)
+{
+    if (isDecimal)
+    {
+        switch (comparison)
+        {
+            case NodeType_GreaterThan:          return a->decimal > b->decimal;
+            case NodeType_LesserThan:           return a->decimal < b->decimal;
+            case NodeType_GreaterThanOrEqual:   return a->decimal >= b->decimal;
+            case NodeType_LesserThanOrEqual:    return a->decimal <= b->decimal;
+            case NodeType_IsEqual:              return a->decimal == b->decimal;
+            case NodeType_IsNotEqual:           return a->decimal != b->decimal;
+            default:                            return false;
+        }
+    }
+
+    switch (comparison)
+    {
+        case NodeType_GreaterThan:          return a->integer > b->integer;
+        case NodeType_LesserThan:           return a->integer < b->integer;
+        case NodeType_GreaterThanOrEqual:   return a->integer >= b->integer;
+        case NodeType_LesserThanOrEqual:    return a->integer <= b->integer;
+        case NodeType_IsEqual:              return a->integer == b->integer;
+        case NodeType_IsNotEqual:           return a->integer != b->integer;
+        default:                            return false;
     }
 }
 
@@ -34,36 +65,49 @@ int interpretConditional(struct ASTNode* node, struct mtScope* scope, bool* resu
     }
 
     struct mtObject* left = interpretExpression(node->children[0], scope);
+    mtGCPushTemp(left);
     struct mtObject* right = interpretExpression(node->children[1], scope);
+    mtGCPopTemps(1);
 
     if (!left || !right)
     {
         return mtWasNotConditional;
     }
 
+    // the type hints already made sure what kind of numbers these are, see markOperands in mtFunction.c
+    // big ints are compared by their type like anything else.
+    struct mtNumber* a = left->data;
+    struct mtNumber* b = right->data;
+    if (node->operands == Operands_Decimal ||
+        (node->operands == Operands_Integer && a->type == INTEGER && b->type == INTEGER))
+    {
+        *result = compareTyped(node->type, a, b, node->operands == Operands_Decimal);
+        return mtSuccess;
+    }
+
     switch(node->type) 
     {   
         case NodeType_GreaterThan:
-            *result =  left->type.isGreater(left->data, right->data);
+            *result =  left->type->isGreater(left->data, right->data);
             break; 
         case NodeType_LesserThan:
-            *result = left->type.isLesser(left->data, right->data);
+            *result = left->type->isLesser(left->data, right->data);
             break; 
 
         case NodeType_GreaterThanOrEqual:
-            *result = left->type.isGreater(left->data, right->data) || left->type.isEqual(left->data, right->data);  // this should probably be its own function
+            *result = left->type->isGreater(left->data, right->data) || left->type->isEqual(left->data, right->data);  // this should probably be its own function
             break; 
         
         case NodeType_LesserThanOrEqual:
-            *result = left->type.isLesser(left->data, right->data) || left->type.isEqual(left->data, right->data);  // this should probably be its own function
+            *result = left->type->isLesser(left->data, right->data) || left->type->isEqual(left->data, right->data);  // this should probably be its own function
             break; 
         
         case NodeType_IsEqual:
-            *result = left->type.isEqual(left->data, right->data);  
+            *result = left->type->isEqual(left->data, right->data);  
             break; 
 
         case NodeType_IsNotEqual:
-            *result = !left->type.isEqual(left->data, right->data);  
+            *result = !left->type->isEqual(left->data, right->data);  
             break; 
 
         default:
@@ -8,7 +8,8 @@
 #define mtWasNotConditional -1
 
 
-void interpretIfStatement(struct ASTNode* node, struct mtScope* scope);
+//@returns the result of the block if it ran, otherwise NULL, see interpretBlock
+struct mtObject* interpretIfStatement(struct ASTNode* node, struct mtScope* scope);
 
 int interpretConditional(struct ASTNode* node, struct mtScope* scope, bool* result);
 
@@ -0,0 +1,381 @@
+
+#include "mtInfer.h"
+
+#include <Mint.h>
+
+// a function's definitions, there can be more than one with the same name.
+struct FunctionInfo {
+    struct ASTNode** definitions;
+    size_t count;
+    size_t capacity;
+
+    // what calls to it can give, its expression statements.
+    enum mtInferredType result;
+};
+
+struct Inference {
+    struct mtHashMap* names; // enum mtInferredType* by variable name
+    struct mtHashMap* functions; // struct FunctionInfo* by function name
+
+    bool changed;
+};
+
+static enum mtInferredType join(enum mtInferredType a, enum mtInferredType b)
+{
+    if (a == Inferred_None || a == b)
+    {
+        return b;
+    }
+    if (b == Inferred_None)
+    {
+        return a;
+    }
+    return Inferred_Mixed;
+}
+
+enum mtInferredType mtInferArithmetic(enum TokenType operator, enum mtInferredType left, enum mtInferredType right)
+{
+    // one of them never has a value, so neither does the result.
+    if (left == Inferred_None || right == Inferred_None)
+    {
+        return Inferred_None;
+    }
+
+    // exact quotients are ints, the others decimals.
+    if (operator == TokenType_OperatorDivision)
+    {
+        return Inferred_Mixed;
+    }
+
+    // a decimal on either side makes the result a decimal.
+    if (left == Inferred_Decimal || right == Inferred_Decimal)
+    {
+        return Inferred_Decimal;
+    }
+    if (left == Inferred_Mixed || right == Inferred_Mixed)
+    {
+        return Inferred_Mixed;
+    }
+    return Inferred_Integer;
+}
+
+static enum mtInferredType* getName(struct Inference* inference, struct Token token)
+{
+    char name[token.size + 1];
+    mtGetTokenString(token, (char*)&name, token.size);
+
+    enum mtInferredType* type = mtHashMapGet(inference->names, name);
+    if (!type)
+    {
+        type = malloc(sizeof(enum mtInferredType));
+        *type = Inferred_None;
+        mtHashMapPut(inference->names, name, type);
+    }
+    return type;
+}
+
+static struct FunctionInfo* getFunction(struct Inference* inference, struct Token token)
+{
+    char name[token.size + 1];
+    mtGetTokenString(token, (char*)&name, token.size);
+
+    return mtHashMapGet(inference->functions, name);
+}
+
+//@brief Adds type to what the name token can hold.
+static void bindName(struct Inference* inference, struct Token token, enum mtInferredType type)
+{
+    enum mtInferredType* current = getName(inference, token);
+    enum mtInferredType joined = join(*current, type);
+    if (joined != *current)
+    {
+        *current = joined;
+        inference->changed = true;
+    }
+}
+
+static void bindResult(struct Inference* inference, struct FunctionInfo* function, enum mtInferredType type)
+{
+    enum mtInferredType joined = join(function->result, type);
+    if (joined != function->result)
+    {
+        function->result = joined;
+        inference->changed = true;
+    }
+}
+
+//@brief Finds every function definition in node, whether it's nested or not.
+static void collectFunctions(struct Inference* inference, struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    if (node->type == NodeType_FunctionDefinition && node->childCount >= 3)
+    {
+        struct FunctionInfo* function = getFunction(inference, node->children[0]->token);
+        if (!function)
+        {
+            function = calloc(1, sizeof(struct FunctionInfo));
+
+            struct Token token = node->children[0]->token;
+            char name[token.size + 1];
+            mtGetTokenString(token, (char*)&name, token.size);
+            mtHashMapPut(inference->functions, name, function);
+        }
+
+        if (function->count >= function->capacity)
+        {
+            function->capacity = function->capacity ? function->capacity * 2 : 2;
+            function->definitions = realloc(function->definitions, sizeof(struct ASTNode*) * function->capacity);
+        }
+        function->definitions[function->count++] = node;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        collectFunctions(inference, node->children[i]);
+    }
+}
+
+static void inferStatements(struct Inference* inference, struct ASTNode* block, struct FunctionInfo* function);
+
+//@brief Infers node and everything in it.
+//
+//@param function the function whose body node is in, NULL at the top level.
+//
+//@returns what node evaluates to.
+static enum mtInferredType infer(struct Inference* inference, struct ASTNode* node, struct FunctionInfo* function)
+{
+    if (node == NULL)
+    {
+        return Inferred_None;
+    }
+
+    enum mtInferredType out = Inferred_None;
+    switch (node->type)
+    {
+        case NodeType_Number:
+            out = node->token.type == TokenType_IntegerLiteral ? Inferred_Integer : Inferred_Decimal;
+            break;
+        case NodeType_Constant:
+            out = node->constant.type == INTEGER ? Inferred_Integer : Inferred_Decimal;
+            break;
+
+        case NodeType_Identifier:
+        case NodeType_InlinedParameter:
+            out = *getName(inference, node->token);
+            break;
+
+        case NodeType_BinaryOperator:
+        {
+            enum mtInferredType left = infer(inference, node->children[0], function);
+            enum mtInferredType right = infer(inference, node->children[1], function);
+            out = mtInferArithmetic(node->token.type, left, right);
+            break;
+        }
+
+        case NodeType_GreaterThan:
+        case NodeType_LesserThan:
+        case NodeType_GreaterThanOrEqual:
+        case NodeType_LesserThanOrEqual:
+        case NodeType_IsEqual:
+        case NodeType_IsNotEqual:
+            for (size_t i = 0; i < node->childCount; i++)
+            {
+                infer(inference, node->children[i], function);
+            }
+            break;
+
+        case NodeType_Assignment:
+            bindName(inference, node->children[0]->token, infer(inference, node->children[1], function));
+            break;
+
+        case NodeType_FunctionCall:
+        {
+            struct ASTNode* argumentList = node->children[1];
+            enum mtInferredType arguments[argumentList->childCount + 1];
+            for (size_t i = 0; i < argumentList->childCount; i++)
+            {
+                arguments[i] = infer(inference, argumentList->children[i], function);
+            }
+
+            struct FunctionInfo* callee = getFunction(inference, node->children[0]->token);
+            if (!callee)
+            {
+                break;
+            }
+
+            for (size_t d = 0; d < callee->count; d++)
+            {
+                struct ASTNode* parameterList = callee->definitions[d]->children[1];
+                if (parameterList->childCount != argumentList->childCount)
+                {
+                    continue;
+                }
+
+                for (size_t i = 0; i < parameterList->childCount; i++)
+                {
+                    struct Token parameter = parameterList->children[i]->token;
+                    bindName(inference, parameter, arguments[i]);
+
+                    // the parameter is the variable, so it can be assigned through the parameter.
+                    if (argumentList->children[i]->type == NodeType_Identifier)
+                    {
+                        bindName(inference, argumentList->children[i]->token, *getName(inference, parameter));
+                    }
+                }
+            }
+            out = callee->result;
+
+            // a copy of the callee's body, see mtInline.h
+            if (node->childCount > 2)
+            {
+                infer(inference, node->children[2], function);
+            }
+            break;
+        }
+
+        case NodeType_FunctionDefinition:
+        {
+            struct FunctionInfo* defined = getFunction(inference, node->children[0]->token);
+            inferStatements(inference, node->children[2], defined);
+            break;
+        }
+
+        case NodeType_ForLoop:
+            bindName(inference, node->children[0]->token, Inferred_Integer);
+            infer(inference, node->children[1], function);
+            infer(inference, node->children[2], function);
+            inferStatements(inference, node->children[3], function);
+            break;
+
+        case NodeType_IfStatement:
+        case NodeType_WhileLoop:
+            infer(inference, node->children[0], function);
+            if (node->childCount > 1)
+            {
+                inferStatements(inference, node->children[1], function);
+            }
+            break;
+
+        default:
+            for (size_t i = 0; i < node->childCount; i++)
+            {
+                infer(inference, node->children[i], function);
+            }
+            break;
+    }
+
+    node->inferred = out;
+    return out;
+}
+
+//@brief Infers the statements in block, the expression statements can be the result of function.
+static void inferStatements(struct Inference* inference, struct ASTNode* block, struct FunctionInfo* function)
+{
+    if (block == NULL)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < block->childCount; i++)
+    {
+        struct ASTNode* statement = block->children[i];
+        enum mtInferredType type = infer(inference, statement, function);
+
+        // the same statements interpretStatements keeps as the result.
+        switch (statement->type)
+        {
+            case NodeType_BinaryOperator:
+            case NodeType_FunctionCall:
+            case NodeType_Identifier:
+            case NodeType_Number:
+            case NodeType_Constant:
+                if (function)
+                {
+                    bindResult(inference, function, type);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+//@brief Marks the operators whose operands are both ints or both decimals.
+static void markOperands(struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_BinaryOperator:
+        case NodeType_GreaterThan:
+        case NodeType_LesserThan:
+        case NodeType_GreaterThanOrEqual:
+        case NodeType_LesserThanOrEqual:
+        case NodeType_IsEqual:
+        case NodeType_IsNotEqual:
+        {
+            if (node->childCount < 2)
+            {
+                break;
+            }
+
+            enum mtInferredType left = node->children[0]->inferred;
+            if (left == node->children[1]->inferred)
+            {
+                if (left == Inferred_Integer)
+                {
+                    node->operands = Operands_Integer;
+                }
+                if (left == Inferred_Decimal)
+                {
+                    node->operands = Operands_Decimal;
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        markOperands(node->children[i]);
+    }
+}
+
+static void freeFunctionInfo(void* value)
+{
+    struct FunctionInfo* function = value;
+    free(function->definitions);
+    free(function);
+}
+
+void mtInferTypes(struct ASTNode* root)
+{
+    struct Inference inference;
+    inference.names = mtHashMapCreate(64);
+    inference.functions = mtHashMapCreate(64);
+
+    collectFunctions(&inference, root);
+
+    // every name and result only ever gets more general, so this stops.
+    // The nodes are set by the last pass, which saw the final types.
+    do
+    {
+        inference.changed = false;
+        inferStatements(&inference, root, NULL);
+    } while (inference.changed);
+
+    markOperands(root);
+
+    mtHashMapDestroy(inference.names, &free);
+    mtHashMapDestroy(inference.functions, &freeFunctionInfo);
+}
@@ -0,0 +1,30 @@
+
+#ifndef mtInfer_h
+#define mtInfer_h
+
+/*
+*   Works out which kind of number every expression can evaluate to, before
+*   the program runs. The result is stored in ASTNode.inferred, and operators
+*   which are known to get two ints or two decimals are marked in
+*   ASTNode.operands so they skip checking, see interpretExpression.
+*
+*   Variables are dynamically scoped and arguments are passed by reference,
+*   so all the variables with the same name are treated as one. A name can
+*   hold whatever is assigned to it, whatever is passed to a parameter with
+*   that name and the integers of loops that count with it. An argument that
+*   is a variable gets whatever its parameter is assigned as well.
+*
+*   Nothing depends on the order the statements run in, the whole program is
+*   gone over until none of the names change anymore.
+*/
+
+#include "mtAST.h"
+
+//@brief Infers the types of every node in root, which has to be the whole program.
+void mtInferTypes(struct ASTNode* root);
+
+//@returns what an arithmetic operator can give for operands of the types left and right,
+// following the promotions in mtNumberObject.c
+enum mtInferredType mtInferArithmetic(enum TokenType operator, enum mtInferredType left, enum mtInferredType right);
+
+#endif
@@ -0,0 +1,151 @@
+
+#include "mtInline.h"
+
+#include <Mint.h>
+
+// marks names with more than one definition, calls to those are left alone.
+static char ambiguous;
+
+static bool tokenEquals(struct Token a, struct Token b)
+{
+    return a.size == b.size && memcmp(a.string, b.string, a.size) == 0;
+}
+
+//@brief Finds every function definition in node, by name.
+static void collectDefinitions(struct mtHashMap* definitions, struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    if (node->type == NodeType_FunctionDefinition && node->childCount >= 3)
+    {
+        struct Token token = node->children[0]->token;
+        char name[token.size + 1];
+        mtGetTokenString(token, (char*)&name, token.size);
+
+        mtHashMapPut(definitions, name, mtHashMapGet(definitions, name) ? (void*)&ambiguous : node);
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        collectDefinitions(definitions, node->children[i]);
+    }
+}
+
+//@returns the number of nodes in expression, or 0 if it isn't only literals, variables and arithmetic.
+static size_t measureExpression(struct ASTNode* node)
+{
+    switch (node->type)
+    {
+        case NodeType_Number:
+        case NodeType_Constant:
+        case NodeType_Identifier:
+            return 1;
+
+        case NodeType_BinaryOperator:
+        {
+            if (node->childCount != 2)
+            {
+                return 0;
+            }
+
+            size_t left = measureExpression(node->children[0]);
+            size_t right = measureExpression(node->children[1]);
+            return (left && right) ? left + right + 1 : 0;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+static bool canInline(struct ASTNode* definition)
+{
+    struct ASTNode* block = definition->children[2];
+    if (block->childCount != 1)
+    {
+        return false;
+    }
+
+    size_t size = measureExpression(block->children[0]);
+    return size > 0 && size <= mtInlineMaxNodes;
+}
+
+//@brief Copies a function's body, its parameters become NodeType_InlinedParameter.
+static struct ASTNode* copyBody(struct ASTNode* node, struct ASTNode* parameterList)
+{
+    struct ASTNode* out = mtASTTokenCreateNode(node->token);
+    out->type = node->type;
+    out->constant = node->constant;
+
+    if (node->type == NodeType_Identifier)
+    {
+        for (size_t i = 0; i < parameterList->childCount; i++)
+        {
+            if (tokenEquals(node->token, parameterList->children[i]->token))
+            {
+                out->type = NodeType_InlinedParameter;
+                out->parameterIndex = i;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        mtASTAddChildNode(out, copyBody(node->children[i], parameterList));
+    }
+    return out;
+}
+
+static void inlineCalls(struct mtHashMap* definitions, struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    // the arguments could have calls of their own.
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        inlineCalls(definitions, node->children[i]);
+    }
+
+    if (node->type != NodeType_FunctionCall || node->childCount != 2)
+    {
+        return;
+    }
+
+    struct Token token = node->children[0]->token;
+    char name[token.size + 1];
+    mtGetTokenString(token, (char*)&name, token.size);
+
+    struct ASTNode* definition = mtHashMapGet(definitions, name);
+    if (!definition || definition == (void*)&ambiguous || !canInline(definition))
+    {
+        return;
+    }
+
+    // the wrong number of arguments is left for the call to complain about.
+    struct ASTNode* parameterList = definition->children[1];
+    if (parameterList->childCount != node->children[1]->childCount)
+    {
+        return;
+    }
+
+    struct ASTNode* body = definition->children[2]->children[0];
+    mtASTAddChildNode(node, copyBody(body, parameterList));
+    node->inlined = definition;
+}
+
+void mtInlineCalls(struct ASTNode* root)
+{
+    struct mtHashMap* definitions = mtHashMapCreate(64);
+
+    collectDefinitions(definitions, root);
+    inlineCalls(definitions, root);
+
+    mtHashMapDestroy(definitions, NULL);
+}
@@ -0,0 +1,31 @@
+
+#ifndef mtInline_h
+#define mtInline_h
+
+/*
+*   Copies the bodies of small functions into the calls to them, so they
+*   don't need a frame, a scope and a block of their own.
+*
+*   Only functions whose body is a single expression of literals, variables
+*   and arithmetic are inlined, ex: func sq(x) x * x end. They can't call
+*   anything, so they aren't recursive, and a function they called couldn't
+*   see their parameters anymore. Variables which aren't parameters are
+*   still looked up by name in the scope of the call, like they would have
+*   been from the function's own scope.
+*
+*   The arguments are evaluated once, in order, and the copied body reads
+*   them like a function reads its parameters. Functions can be defined
+*   again while the program runs, so the call checks that its name still
+*   means the definition that was copied, otherwise the function is called
+*   as usual. The definition itself is left alone for those calls.
+*/
+
+#include "mtAST.h"
+
+// nodes in a function's body, bigger ones aren't inlined.
+#define mtInlineMaxNodes 16
+
+//@brief Inlines the calls in root, which has to be the whole program.
+void mtInlineCalls(struct ASTNode* root);
+
+#endif
@@ -1,8 +1,146 @@
 #include "mtInterpreter.h"
 
 #include "mtBlock.h"
+#include "mtFunction.h"
+#include "mtInfer.h"
+#include "mtInline.h"
+#include "mtOptimize.h"
+#include "mtPartialEval.h"
 
-void mtInterpret(struct ASTNode* node)
+#include <Mint.h>
+
+#ifdef mtLinux
+    #include <sys/resource.h>
+    #include <pthread.h>
+#endif
+
+static bool halted = false;
+
+// where the C stack was when mtInterpret started, and how far it may grow from there.
+static char* stackBase = NULL;
+static size_t stackLimit = 0;
+
+static size_t getCStackSize()
 {
+#ifdef mtLinux
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+    {
+        return limit.rlim_cur;
+    }
+#endif
+    return mtDefaultCStackSize;
+}
+
+//@brief Runs node on the stack the caller is on, which is stackSize bytes big.
+static void run(struct ASTNode* node, size_t stackSize)
+{
+    char base;
+    stackBase = &base;
+    // leave some room for whatever runs after the check, printing errors etc.
+    stackLimit = stackSize > 2 * mtCStackReserve ? stackSize - mtCStackReserve : stackSize / 2;
+
+    mtPartialEvaluate(node);
+    mtInlineCalls(node);
+    mtInferTypes(node);
+    mtOptimize(node);
     interpretBlock(node, NULL);
+
+    // nothing is rooted anymore, so this frees whatever is left.
+    mtGCCollect();
+    mtFreePrototypes(node);
+}
+
+#ifdef mtLinux
+struct Run {
+    struct ASTNode* node;
+    size_t stackSize;
+};
+
+static void* runThread(void* data)
+{
+    struct Run* r = data;
+    run(r->node, r->stackSize);
+    return NULL;
+}
+
+//@brief Runs node on a thread with a stack of stackSize bytes, and waits for it.
+//
+//@returns false if the thread couldn't be started, nothing was run then.
+static bool runOnStack(struct ASTNode* node, size_t stackSize)
+{
+    pthread_attr_t attributes;
+    if (pthread_attr_init(&attributes) != 0)
+    {
+        return false;
+    }
+
+    struct Run r = { node, stackSize };
+    pthread_t thread;
+    bool started = pthread_attr_setstacksize(&attributes, stackSize) == 0 &&
+                   pthread_create(&thread, &attributes, &runThread, &r) == 0;
+    pthread_attr_destroy(&attributes);
+
+    if (started)
+    {
+        pthread_join(thread, NULL);
+    }
+    return started;
+}
+#endif
+
+int mtInterpret(struct ASTNode* node)
+{
+    halted = false;
+
+    size_t stackSize = getCStackSize();
+
+#ifdef mtLinux
+    // calls nest on the C stack, so the program gets a stack that fits as many as it's allowed.
+    // It's only backed by memory as far as the calls really go.
+    size_t wanted;
+    if (!__builtin_mul_overflow(mtGetMaxCallDepth(), (size_t)mtCallCStackCost, &wanted) &&
+        !__builtin_add_overflow(wanted, (size_t)mtCStackReserve, &wanted) &&
+        wanted > stackSize && runOnStack(node, wanted))
+    {
+        return halted ? mtFail : mtSuccess;
+    }
+#endif
+
+    // it can still run out of stack before the depth limit, which is an error like the limit is.
+    run(node, stackSize);
+    return halted ? mtFail : mtSuccess;
+}
+
+void mtHalt()
+{
+    halted = true;
+}
+
+bool mtIsHalted()
+{
+    return halted;
+}
+
+static size_t getCStackUsed()
+{
+    char current;
+    // the stack could grow either way.
+    return (&current < stackBase) ? (size_t)(stackBase - &current) : (size_t)(&current - stackBase);
+}
+
+bool mtIsCStackExhausted()
+{
+    return getCStackUsed() > stackLimit;
+}
+
+size_t mtGetCStackLeft()
+{
+    size_t used = getCStackUsed();
+    return used < stackLimit ? stackLimit - used : 0;
+}
+
+size_t mtGetCStackLimit()
+{
+    return stackLimit;
 }
@@ -10,5 +10,26 @@
 #include "mtHashmap.h"
 #include "mtAST.h"
 
-void mtInterpret(struct ASTNode* node);
+// used when the real size of the stack can't be found out, the smallest common default is 1MB.
+#define mtDefaultCStackSize (1024 * 1024)
+// how much of the stack is kept free for the code running after the last check.
+#define mtCStackReserve     (256 * 1024)
+
+//@returns mtSuccess, or mtFail if the interpreter was halted.
+int mtInterpret(struct ASTNode* node);
+
+//@brief Stops the interpreter after an error it can't continue from,
+// every block returns as soon as its current statement is done.
+void mtHalt();
+bool mtIsHalted();
+
+//@returns true once the interpreter has used up most of the C stack,
+// nothing deeper should be started after that.
+bool mtIsCStackExhausted();
+
+//@returns how many more bytes of C stack can be used before mtIsCStackExhausted.
+size_t mtGetCStackLeft();
+
+//@returns how many bytes of C stack the interpreter can use in all, set by mtInterpret.
+size_t mtGetCStackLimit();
 #endif
@@ -3,14 +3,26 @@
 #define mtInterpreterError_h
 
 #include "mtAST.h"
+#include "mtInterpreter.h"
 
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "mtOutput.h"
+
 static void interpreterError(struct ASTNode* node, const char* fmt, ...)
 {
+    // whatever goes wrong after a halt is only a consequence of the error that halted it.
+    if (mtIsHalted())
+    {
+        return;
+    }
+
     va_list args;
     va_start(args, fmt);
+
+    // the output printed before the error goes first.
+    mtOutputFlush();
     fprintf(stderr, "Error while interpreting on line %d: \n\t", 
             node->token.line 
     );
@@ -19,7 +31,7 @@ static void interpreterError(struct ASTNode* node, const char* fmt, ...)
 
     if (fmt[strlen(fmt)] != '\n')
     {
-        printf("\n");
+        mtOutputWrite("\n", 1);
     }
 }
 
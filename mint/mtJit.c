@@ -0,0 +1,566 @@
+#include "mtJit.h"
+
+#include "mtFunction.h"
+#include "mtInterpreter.h"
+
+#ifdef mtJitSupported
+    #include <sys/mman.h>
+#endif
+
+void mtJitInit(struct mtJitCode* code)
+{
+    code->state = mtJitNotCompiled;
+    code->entry = NULL;
+    code->memory = NULL;
+    code->size = 0;
+    code->epoch = 0;
+    code->calls = 0;
+    code->bails = 0;
+}
+
+void mtJitRelease(struct mtJitCode* code)
+{
+#ifdef mtJitSupported
+    if (code->memory)
+    {
+        munmap(code->memory, code->size);
+    }
+#endif
+    code->memory = NULL;
+    code->entry = NULL;
+    code->size = 0;
+}
+
+#ifdef mtJitSupported
+
+/*
+*   Every compiled function takes a pointer to its arguments in rdi, one 64 bit 
+*   slot per argument, and returns its result in rax and a status in rdx.
+*   The values themselves are 64 bit integers, like mtNumber's, a result which
+*   doesn't fit in one bails so the interpreter can make a big int of it.
+*
+*   The frame:
+*       [rbp - 8]   saved rbx, which holds the arguments' pointer
+*       [rbp - 16]  the result, of the only expression statement that ran, see storeResult
+*       [rbp - 24]  the status
+*
+*   Expressions are evaluated into rax, with intermediate values pushed to the stack.
+*/
+
+enum {
+    Status_NoResult,
+    Status_Result,
+    Status_Bail
+};
+
+struct mtJitResult {
+    int64_t value;
+    int64_t status;
+};
+
+typedef struct mtJitResult (*mtJitFunction)(const int64_t* arguments);
+
+// how many compiled calls are nested and how many may be, set before compiled code is entered.
+static int64_t nativeDepth = 0;
+static int64_t nativeMaxDepth = 0;
+// compiled code gives up once the stack pointer is below this.
+static uintptr_t nativeStackLimit = 0;
+
+struct Emitter {
+    unsigned char* code;
+    size_t size;
+    size_t capacity;
+
+    // the offsets of the jumps that go to the bail label.
+    size_t* bails;
+    size_t bailCount;
+    size_t bailCapacity;
+
+    struct mtFunction* func;
+    struct mtScope* scope; // where called functions are looked up
+
+    bool failed;
+};
+
+static void emit(struct Emitter* e, const unsigned char* bytes, size_t count)
+{
+    if (e->size + count > e->capacity)
+    {
+        e->capacity = (e->capacity + count) * 2;
+        e->code = realloc(e->code, e->capacity);
+    }
+    memcpy(e->code + e->size, bytes, count);
+    e->size += count;
+}
+
+#define Emit(e, ...)                                                \
+    do {                                                            \
+        const unsigned char bytes[] = { __VA_ARGS__ };              \
+        emit(e, bytes, sizeof(bytes));                              \
+    } while (0)
+
+static void emit32(struct Emitter* e, uint32_t value)
+{
+    emit(e, (const unsigned char*)&value, sizeof(value));
+}
+
+static void emit64(struct Emitter* e, uint64_t value)
+{
+    emit(e, (const unsigned char*)&value, sizeof(value));
+}
+
+//@returns the offset of the jump's rel32, to be filled in by patchJump.
+static size_t emitJumpPlaceholder(struct Emitter* e)
+{
+    size_t offset = e->size;
+    emit32(e, 0);
+    return offset;
+}
+
+//@brief Makes the rel32 at offset jump to target.
+static void patchJump(struct Emitter* e, size_t offset, size_t target)
+{
+    int32_t rel = (int32_t)(target - (offset + 4));
+    memcpy(e->code + offset, &rel, sizeof(rel));
+}
+
+//@brief Emits a jcc rel32 to the bail label, condition is the second opcode byte.
+static void emitBailIf(struct Emitter* e, unsigned char condition)
+{
+    Emit(e, 0x0F, condition);
+
+    if (e->bailCount >= e->bailCapacity)
+    {
+        e->bailCapacity = e->bailCapacity ? e->bailCapacity * 2 : 16;
+        e->bails = realloc(e->bails, sizeof(size_t) * e->bailCapacity);
+    }
+    e->bails[e->bailCount++] = emitJumpPlaceholder(e);
+}
+
+#define JumpOverflow        0x80
+#define JumpEqual           0x84
+#define JumpNotEqual        0x85
+#define JumpBelow           0x82
+#define JumpLess            0x8C
+#define JumpGreaterOrEqual  0x8D
+#define JumpLessOrEqual     0x8E
+#define JumpGreater         0x8F
+
+static bool prepare(struct mtFunction* func, struct mtScope* scope);
+
+static void compileExpression(struct Emitter* e, struct ASTNode* node);
+
+//@brief Calls node's function, the status ends up in rdx and the result in rax.
+static void compileCall(struct Emitter* e, struct ASTNode* node)
+{
+    struct ASTNode* identifier = node->children[0];
+    struct ASTNode* argumentList = node->children[1];
+
+    struct mtFunction* callee = getFunctionFromScopeN(e->scope, identifier->token.string, 
+                                                      identifier->token.size, identifier->hash);
+    if (!callee || callee->parameterCount != argumentList->childCount || !prepare(callee, e->scope))
+    {
+        e->failed = true;
+        return;
+    }
+
+    // pushed backwards, so the first argument ends up at the lowest address.
+    size_t count = argumentList->childCount;
+    for (size_t i = count; i > 0; i--)
+    {
+        compileExpression(e, argumentList->children[i - 1]);
+        Emit(e, 0x50);                                  // push rax
+    }
+    Emit(e, 0x48, 0x89, 0xE7);                          // mov rdi, rsp
+
+    // through the entry, so the callee can still be compiled or recompiled later.
+    Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)(uintptr_t)&callee->jit.entry); // mov rax, &entry
+    Emit(e, 0x48, 0x8B, 0x00);                          // mov rax, [rax]
+    Emit(e, 0x48, 0x85, 0xC0);                          // test rax, rax
+    emitBailIf(e, JumpEqual);
+    Emit(e, 0xFF, 0xD0);                                // call rax
+
+    if (count > 0)
+    {
+        Emit(e, 0x48, 0x81, 0xC4); emit32(e, (uint32_t)(count * 8)); // add rsp, count * 8
+    }
+}
+
+static void compileExpression(struct Emitter* e, struct ASTNode* node)
+{
+    if (e->failed || node == NULL)
+    {
+        e->failed = true;
+        return;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Number:
+        {
+            // decimals, and ints too big for a register, are left to the interpreter.
+            struct mtNumber number;
+            number.type = DECIMAL;
+            if (node->token.type == TokenType_IntegerLiteral)
+            {
+                mtInterpretInteger(&node->token, &number);
+            }
+            if (number.type != INTEGER)
+            {
+                e->failed = true;
+                return;
+            }
+            Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)number.integer); // mov rax, imm64
+            return;
+        }
+
+        case NodeType_Constant:
+            if (node->constant.type != INTEGER)
+            {
+                e->failed = true;
+                return;
+            }
+            Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)node->constant.integer); // mov rax, imm64
+            return;
+
+        case NodeType_Identifier:
+            if (node->parameterIndex < 0 || (size_t)node->parameterIndex >= e->func->parameterCount)
+            {
+                e->failed = true;
+                return;
+            }
+            Emit(e, 0x48, 0x8B, 0x83); emit32(e, (uint32_t)(node->parameterIndex * 8)); // mov rax, [rbx + index * 8]
+            return;
+
+        case NodeType_FunctionCall:
+            compileCall(e, node);
+            // a call without a result can't be used as a value.
+            Emit(e, 0x48, 0x83, 0xFA, Status_Result);   // cmp rdx, Status_Result
+            emitBailIf(e, JumpNotEqual);
+            return;
+
+        case NodeType_BinaryOperator:
+            break;
+
+        default:
+            e->failed = true;
+            return;
+    }
+
+    compileExpression(e, node->children[0]);
+    Emit(e, 0x50);                                      // push rax
+    compileExpression(e, node->children[1]);
+    Emit(e, 0x48, 0x89, 0xC1);                          // mov rcx, rax
+    Emit(e, 0x58);                                      // pop rax
+
+    // results that overflow are big ints, which only the interpreter makes.
+    switch (node->token.type)
+    {
+        case TokenType_OperatorAddition:
+            Emit(e, 0x48, 0x01, 0xC8);                  // add rax, rcx
+            emitBailIf(e, JumpOverflow);
+            break;
+        case TokenType_OperatorSubtraction:
+            Emit(e, 0x48, 0x29, 0xC8);                  // sub rax, rcx
+            emitBailIf(e, JumpOverflow);
+            break;
+        case TokenType_OperatorMultiplication:
+            Emit(e, 0x48, 0x0F, 0xAF, 0xC1);            // imul rax, rcx
+            emitBailIf(e, JumpOverflow);
+            break;
+        case TokenType_OperatorDivision:
+            // the interpreter reports dividing by zero, 
+            // and a quotient that isn't an integer is a decimal.
+            Emit(e, 0x48, 0x85, 0xC9);                  // test rcx, rcx
+            emitBailIf(e, JumpEqual);
+            // idiv faults on INT64_MIN / -1, which doesn't fit anyway.
+            Emit(e, 0x48, 0x83, 0xF9, 0xFF);            // cmp rcx, -1
+            emitBailIf(e, JumpEqual);
+            Emit(e, 0x48, 0x99);                        // cqo
+            Emit(e, 0x48, 0xF7, 0xF9);                  // idiv rcx
+            Emit(e, 0x48, 0x85, 0xD2);                  // test rdx, rdx
+            emitBailIf(e, JumpNotEqual);
+            break;
+        default:
+            e->failed = true;
+            break;
+    }
+}
+
+//@brief Compares the condition's sides and jumps if it's false.
+//
+//@returns the offset of the jump, see patchJump.
+static size_t compileCondition(struct Emitter* e, struct ASTNode* node)
+{
+    if (node == NULL || node->childCount < 2)
+    {
+        e->failed = true;
+        return 0;
+    }
+
+    unsigned char jumpIfFalse;
+    switch (node->type)
+    {
+        case NodeType_GreaterThan:          jumpIfFalse = JumpLessOrEqual;      break;
+        case NodeType_LesserThan:           jumpIfFalse = JumpGreaterOrEqual;   break;
+        case NodeType_GreaterThanOrEqual:   jumpIfFalse = JumpLess;             break;
+        case NodeType_LesserThanOrEqual:    jumpIfFalse = JumpGreater;          break;
+        case NodeType_IsEqual:              jumpIfFalse = JumpNotEqual;         break;
+        case NodeType_IsNotEqual:           jumpIfFalse = JumpEqual;            break;
+        default:
+            e->failed = true;
+            return 0;
+    }
+
+    compileExpression(e, node->children[0]);
+    Emit(e, 0x50);                                      // push rax
+    compileExpression(e, node->children[1]);
+    Emit(e, 0x48, 0x89, 0xC1);                          // mov rcx, rax
+    Emit(e, 0x58);                                      // pop rax
+    Emit(e, 0x48, 0x39, 0xC8);                          // cmp rax, rcx
+
+    Emit(e, 0x0F, jumpIfFalse);
+    return emitJumpPlaceholder(e);
+}
+
+//@brief Makes rax the result, bails if there already is one, the interpreter prints that one.
+static void storeResult(struct Emitter* e)
+{
+    Emit(e, 0x48, 0x83, 0x7D, 0xE8, Status_Result);    // cmp qword [rbp - 24], Status_Result
+    emitBailIf(e, JumpEqual);
+    Emit(e, 0x48, 0x89, 0x45, 0xF0);                    // mov [rbp - 16], rax
+    Emit(e, 0x48, 0xC7, 0x45, 0xE8); emit32(e, Status_Result); // mov qword [rbp - 24], Status_Result
+}
+
+static void compileStatements(struct Emitter* e, struct ASTNode* block)
+{
+    for (size_t i = 0; i < block->childCount && !e->failed; i++)
+    {
+        struct ASTNode* node = block->children[i];
+        switch (node->type)
+        {
+            case NodeType_IfStatement:
+            {
+                if (node->childCount < 2)
+                {
+                    e->failed = true;
+                    return;
+                }
+                size_t skip = compileCondition(e, node->children[0]);
+                compileStatements(e, node->children[1]);
+                patchJump(e, skip, e->size);
+                break;
+            }
+
+            case NodeType_FunctionCall:
+            {
+                // as a statement a call without a result leaves the result alone.
+                compileCall(e, node);
+                Emit(e, 0x48, 0x83, 0xFA, Status_Bail);  // cmp rdx, Status_Bail
+                emitBailIf(e, JumpEqual);
+                Emit(e, 0x48, 0x85, 0xD2);              // test rdx, rdx
+                Emit(e, 0x0F, JumpEqual);
+                size_t skip = emitJumpPlaceholder(e);
+                storeResult(e);
+                patchJump(e, skip, e->size);
+                break;
+            }
+
+            case NodeType_BinaryOperator:
+            case NodeType_Identifier:
+            case NodeType_Number:
+            case NodeType_Constant:
+                compileExpression(e, node);
+                storeResult(e);
+                break;
+
+            // anything that could change a variable or the scope.
+            default:
+                e->failed = true;
+                return;
+        }
+    }
+}
+
+static void compilePrologue(struct Emitter* e)
+{
+    Emit(e, 0x55);                                      // push rbp
+    Emit(e, 0x48, 0x89, 0xE5);                          // mov rbp, rsp
+    Emit(e, 0x53);                                      // push rbx
+    Emit(e, 0x48, 0x83, 0xEC, 0x18);                    // sub rsp, 24
+    Emit(e, 0x48, 0x89, 0xFB);                          // mov rbx, rdi
+
+    Emit(e, 0x48, 0xC7, 0x45, 0xF0); emit32(e, 0);      // mov qword [rbp - 16], 0
+    Emit(e, 0x48, 0xC7, 0x45, 0xE8); emit32(e, Status_NoResult); // mov qword [rbp - 24], Status_NoResult
+
+    // the epilogue decrements the depth again, even when bailing.
+    Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)(uintptr_t)&nativeDepth); // mov rax, &nativeDepth
+    Emit(e, 0x48, 0x8B, 0x08);                          // mov rcx, [rax]
+    Emit(e, 0x48, 0xFF, 0xC1);                          // inc rcx
+    Emit(e, 0x48, 0x89, 0x08);                          // mov [rax], rcx
+    Emit(e, 0x48, 0xBA); emit64(e, (uint64_t)(uintptr_t)&nativeMaxDepth); // mov rdx, &nativeMaxDepth
+    Emit(e, 0x48, 0x3B, 0x0A);                          // cmp rcx, [rdx]
+    emitBailIf(e, JumpGreater);
+
+    Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)(uintptr_t)&nativeStackLimit); // mov rax, &nativeStackLimit
+    Emit(e, 0x48, 0x3B, 0x20);                          // cmp rsp, [rax]
+    emitBailIf(e, JumpBelow);
+}
+
+static void compileEpilogue(struct Emitter* e)
+{
+    size_t epilogue = e->size;
+    Emit(e, 0x48, 0xB8); emit64(e, (uint64_t)(uintptr_t)&nativeDepth); // mov rax, &nativeDepth
+    Emit(e, 0x48, 0xFF, 0x08);                          // dec qword [rax]
+
+    Emit(e, 0x48, 0x8B, 0x45, 0xF0);                    // mov rax, [rbp - 16]
+    Emit(e, 0x48, 0x8B, 0x55, 0xE8);                    // mov rdx, [rbp - 24]
+    Emit(e, 0x48, 0x8D, 0x65, 0xF8);                    // lea rsp, [rbp - 8]
+    Emit(e, 0x5B);                                      // pop rbx
+    Emit(e, 0x5D);                                      // pop rbp
+    Emit(e, 0xC3);                                      // ret
+
+    size_t bail = e->size;
+    Emit(e, 0x48, 0xC7, 0x45, 0xE8); emit32(e, Status_Bail); // mov qword [rbp - 24], Status_Bail
+    Emit(e, 0xE9);                                      // jmp epilogue
+    patchJump(e, emitJumpPlaceholder(e), epilogue);
+
+    for (size_t i = 0; i < e->bailCount; i++)
+    {
+        patchJump(e, e->bails[i], bail);
+    }
+}
+
+static bool compile(struct mtFunction* func, struct mtScope* scope)
+{
+    struct mtJitCode* code = &func->jit;
+    code->state = mtJitCompiling;
+
+    struct Emitter e;
+    memset(&e, 0, sizeof(e));
+    e.func = func;
+    e.scope = scope;
+
+    compilePrologue(&e);
+    compileStatements(&e, func->block);
+    compileEpilogue(&e);
+
+    void* memory = MAP_FAILED;
+    if (!e.failed)
+    {
+        memory = mmap(NULL, e.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (memory != MAP_FAILED)
+    {
+        memcpy(memory, e.code, e.size);
+        if (mprotect(memory, e.size, PROT_READ | PROT_EXEC) != 0)
+        {
+            munmap(memory, e.size);
+            memory = MAP_FAILED;
+        }
+    }
+
+    free(e.code);
+    free(e.bails);
+
+    if (memory == MAP_FAILED)
+    {
+        code->state = mtJitFailed;
+        return false;
+    }
+
+    code->memory = memory;
+    code->size = e.size;
+    code->entry = memory;
+    code->epoch = mtScopeGetFunctionEpoch();
+    code->state = mtJitCompiled;
+
+    return true;
+}
+
+//@brief Makes sure func is compiled against the current functions.
+//
+//@returns false if it can't be compiled.
+static bool prepare(struct mtFunction* func, struct mtScope* scope)
+{
+    struct mtJitCode* code = &func->jit;
+    if (code->state == mtJitCompiled && code->epoch != mtScopeGetFunctionEpoch())
+    {
+        // the functions it calls could be different ones by now.
+        mtJitRelease(code);
+        code->state = mtJitNotCompiled;
+    }
+
+    switch (code->state)
+    {
+        case mtJitCompiled:
+        // a recursive call, it goes through the entry which is set once this is done.
+        case mtJitCompiling:
+            return true;
+        case mtJitFailed:
+            return false;
+        default:
+            return compile(func, scope);
+    }
+}
+
+bool mtJitRun(struct mtFunction* func, struct mtObject** arguments, struct mtScope* scope, 
+              size_t depth, size_t maxDepth, struct mtObject** result)
+{
+    struct mtJitCode* code = &func->jit;
+    if (code->state == mtJitFailed || code->bails >= mtJitMaxBails)
+    {
+        return false;
+    }
+    if (++code->calls < mtJitThreshold || !prepare(func, scope) || !code->entry)
+    {
+        return false;
+    }
+
+    // the type guard, compiled code only handles integers.
+    size_t count = func->parameterCount;
+    int64_t values[count + 1];
+    for (size_t i = 0; i < count; i++)
+    {
+        struct mtNumber* number = arguments[i]->data;
+        if (arguments[i]->type != &mtNumberType || number->type != INTEGER)
+        {
+            return false;
+        }
+        values[i] = number->integer;
+    }
+
+    char stackPosition;
+    nativeDepth = 0;
+    nativeMaxDepth = (int64_t)(maxDepth - depth);
+    nativeStackLimit = (uintptr_t)&stackPosition - mtGetCStackLeft();
+
+    struct mtJitResult out = ((mtJitFunction)code->entry)(values);
+    if (out.status == Status_Bail)
+    {
+        code->bails++;
+        return false;
+    }
+
+    *result = NULL;
+    if (out.status == Status_Result)
+    {
+        struct mtNumber value;
+        value.type = INTEGER;
+        value.integer = out.value;
+
+        *result = mtCreateTempObject(&mtNumberType);
+        (*result)->type->set((*result)->data, &value);
+    }
+    return true;
+}
+
+#else
+
+bool mtJitRun(struct mtFunction* func, struct mtObject** arguments, struct mtScope* scope, 
+              size_t depth, size_t maxDepth, struct mtObject** result)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,72 @@
+
+#ifndef mtJit_h
+#define mtJit_h
+
+/*
+*   A baseline compiler from function bodies to x86-64 machine code.
+*
+*   Functions are only compiled once they were called mtJitThreshold times,
+*   and only if their bodies are made of integer arithmetic, comparisons,
+*   if statements, reads of their parameters and calls to other functions
+*   which can be compiled. Such functions can't change anything, so the
+*   compiled code doesn't have to be able to resume in the interpreter:
+*   whenever it runs into something it doesn't handle, a division with a
+*   remainder, a result too big for 64 bits, too many nested calls, it gives
+*   up and the whole call is run again by the interpreter instead.
+*
+*   The compiled code is specialized for integers, calls with any other
+*   arguments are interpreted. Only x86-64 Linux is supported, anywhere
+*   else every compilation simply fails.
+*/
+
+#include <Mint.h>
+
+// calls before a function is compiled.
+#define mtJitThreshold  100
+
+// times compiled code can give up before the function is left to the interpreter for good.
+#define mtJitMaxBails   16
+
+#if defined(mtLinux) && defined(__x86_64__)
+    #define mtJitSupported
+#endif
+
+struct mtFunction;
+
+struct mtJitCode {
+    enum {
+        mtJitNotCompiled,
+        mtJitCompiling,
+        mtJitCompiled,
+        mtJitFailed
+    } state;
+
+    // what compiled code calls, NULL until the function is compiled.
+    void* entry;
+
+    // the mmap'd code
+    void* memory;
+    size_t size;
+
+    size_t epoch; // the function epoch the calls were resolved in
+    size_t calls;
+    size_t bails;
+};
+
+//@brief Sets code up as not compiled.
+void mtJitInit(struct mtJitCode* code);
+
+//@brief Frees the machine code.
+void mtJitRelease(struct mtJitCode* code);
+
+//@brief Counts a call to func, runs it if it's compiled or compiles it once it's hot.
+//
+//@param arguments the call's arguments, there are func->parameterCount of them.
+//@param scope the scope of the call, used to find the functions func calls.
+//@param result the result of the call, NULL if there was none.
+//
+//@returns true if the call was run, false if it has to be interpreted instead.
+bool mtJitRun(struct mtFunction* func, struct mtObject** arguments, struct mtScope* scope, 
+              size_t depth, size_t maxDepth, struct mtObject** result);
+
+#endif
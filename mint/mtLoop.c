@@ -0,0 +1,161 @@
+#include "mtLoop.h"
+
+#include <Mint.h>
+
+#include "mtBlock.h"
+#include "mtExpression.h"
+#include "mtFunction.h"
+#include "mtIfStatement.h"
+#include "mtInterpreter.h"
+
+#include "mtInterpreterError.h"
+
+//@returns true if the loop should stop after the current iteration.
+static bool shouldStop(struct mtCallFrame* frame)
+{
+    return mtIsHalted() || (frame && frame->tailCall);
+}
+
+//@brief Frees an iteration's temporaries except for the loop's result so far.
+static struct mtObject* keepResult(struct mtCallFrame* frame, struct mtArenaMark mark, struct mtObject* result)
+{
+    result = mtTempReleaseKeeping(mark, result);
+
+    // it's the newest result the call has, which was just moved.
+    if (frame && result)
+    {
+        frame->result = result;
+    }
+    return result;
+}
+
+struct mtObject* interpretWhileLoop(struct ASTNode* node, struct mtScope* scope)
+{
+    struct ASTNode* condition = node->children[0];
+    struct ASTNode* body = node->children[1];
+
+    struct mtScope loopScope;
+    mtInitScope(&loopScope, scope);
+    mtGCPushScope(&loopScope);
+
+    struct mtCallFrame* frame = mtGetCurrentFrame();
+    struct mtObject* result = NULL;
+
+    // every iteration's temporaries are freed before the next one starts.
+    struct mtArenaMark mark = mtTempMark();
+
+    while (true)
+    {
+        bool conditional = false;
+        if (interpretConditional(condition, &loopScope, &conditional) != mtSuccess)
+        {
+            interpreterError(node, "Could not interpret conditional!");
+            break;
+        }
+        if (!conditional)
+        {
+            break;
+        }
+
+        struct mtObject* iteration = interpretStatements(body, &loopScope);
+        result = keepResult(frame, mark, iteration ? iteration : result);
+
+        if (shouldStop(frame))
+        {
+            break;
+        }
+    }
+
+    mtGCPopScope();
+    mtReleaseScope(&loopScope, NULL);
+
+    return result;
+}
+
+//@brief Evaluates one of a for loop's bounds into value.
+//
+//@returns false if it isn't an integer.
+static bool interpretBound(struct ASTNode* node, struct mtScope* scope, int64_t* value)
+{
+    struct mtObject* bound = interpretExpression(node, scope);
+    if (!bound || bound->type != &mtNumberType)
+    {
+        return false;
+    }
+
+    struct mtNumber* number = bound->data;
+    if (number->type != INTEGER)
+    {
+        return false;
+    }
+
+    *value = number->integer;
+    return true;
+}
+
+struct mtObject* interpretForLoop(struct ASTNode* node, struct mtScope* scope)
+{
+    // children of the for node:
+    // 1st      child: the counter's identifier
+    // 2nd      child: the first value
+    // 3rd      child: the last value
+    // 4th      child: block
+    struct Token identifier = node->children[0]->token;
+    struct ASTNode* body = node->children[3];
+
+    int64_t first = 0;
+    int64_t last = 0;
+    if (!interpretBound(node->children[1], scope, &first) || 
+        !interpretBound(node->children[2], scope, &last))
+    {
+        interpreterError(node, "The first and last value of a for loop must be integers!");
+        return NULL;
+    }
+    if (first > last)
+    {
+        return NULL;
+    }
+
+    char counterName[identifier.size + 1];
+    mtGetTokenString(identifier, (char*)&counterName, identifier.size);
+    const char* slotName = counterName;
+
+    // the counter is the loop scope's only slot, the body finds it by name.
+    struct mtObject* counter = mtCreateTempObject(&mtNumberType);
+
+    struct mtScope loopScope;
+    mtInitScope(&loopScope, scope);
+    loopScope.slots = &counter;
+    loopScope.slotNames = &slotName;
+    loopScope.slotCount = 1;
+    mtGCPushScope(&loopScope);
+
+    struct mtCallFrame* frame = mtGetCurrentFrame();
+    struct mtObject* result = NULL;
+
+    struct mtArenaMark mark = mtTempMark();
+
+    // the count is kept in i, the body only sees a copy of it, 
+    // so assigning to the counter doesn't change how often the loop runs.
+    for (int64_t i = first; ; i++)
+    {
+        struct mtNumber value;
+        value.type = INTEGER;
+        value.integer = i;
+        counter->type->set(counter->data, &value);
+
+        struct mtObject* iteration = interpretStatements(body, &loopScope);
+        result = keepResult(frame, mark, iteration ? iteration : result);
+
+        // checked before incrementing, so a last value of INT64_MAX doesn't overflow.
+        if (i == last || shouldStop(frame))
+        {
+            break;
+        }
+    }
+
+    mtGCPopScope();
+    mtReleaseScope(&loopScope, NULL);
+
+    return result;
+}
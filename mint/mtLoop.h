@@ -0,0 +1,19 @@
+#ifndef mtLoop_h
+#define mtLoop_h
+
+#include "mtAST.h"
+#include "mtScope.h"
+#include "mtUtilities.h"
+
+// Both loops run their body in one scope which is reused by every iteration,
+// only the last iteration's result is kept.
+
+//@returns the result of the last iteration, see interpretBlock, or NULL if the body never ran.
+struct mtObject* interpretWhileLoop(struct ASTNode* node, struct mtScope* scope);
+
+//@brief Runs the body once for every integer from the first to the last value, both included.
+//
+//@returns the result of the last iteration, see interpretBlock, or NULL if the body never ran.
+struct mtObject* interpretForLoop(struct ASTNode* node, struct mtScope* scope);
+
+#endif
@@ -9,6 +9,8 @@
 #include "mtParser.h"
 #include "mtInterpreter.h"
 #include "mtUtilities.h"
+#include "mtFunction.h"
+#include "mtEmitC.h"
 
 #define mtVersion "0.4"
 
@@ -27,6 +29,7 @@ const struct TokenTypeRules rules = {
     .exclamationChar        = '!',
 
     .commaChar              = ',',
+    .colonChar              = ':',
 
     .endOfFileChar          = '\0',
     .endStatementChar       = '\n',
@@ -35,11 +38,16 @@ const struct TokenTypeRules rules = {
     .numbers = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'},
     .functionKeyword = "func",
     .endKeyword = "end",
-    .ifKeyword = "if"
+    .ifKeyword = "if",
+    .whileKeyword = "while",
+    .forKeyword = "for"
 };
 
-void mtExecute(char* string)
+//@param emitC write the program as C to stdout instead of running it.
+int mtExecute(char* string, bool emitC)
 {
+    int result = mtSuccess;
+
     size_t tokenCount = 0; 
     struct Token* tokens = mtTokenize(string, rules, &tokenCount);
 
@@ -48,25 +56,88 @@ void mtExecute(char* string)
 
     if (rootNode != NULL)
     {
-        mtInterpret(rootNode);
+        result = emitC ? mtEmitC(rootNode, stdout) : mtInterpret(rootNode);
         mtASTFree(rootNode);
     }
     free(tokens);
+
+    return result;
+}
+
+void mtPrintUsage()
+{
+    mtOutputPrintf("Usage:\n\t Mint [options] [file]\n");
+    mtOutputPrintf("Options:\n");
+    mtOutputPrintf("\t--gc-stats\tprint garbage collector statistics on exit\n");
+    mtOutputPrintf("\t--emit-c\twrite the program as C to stdout instead of running it, see mint/mtEmitC.h\n");
+    mtOutputPrintf("\t--jit\t\tcompile hot integer functions to machine code, x86-64 Linux only\n");
+    mtOutputPrintf("\t--memoize\tcache the results of functions which only depend on their arguments\n");
+    mtOutputPrintf("\t--max-depth n\tstop with an error once n calls are nested, defaults to 100000, the stack is sized for it\n");
 }
 
 int main(int argc, char* argv[])
 {
 
-    printf("Mint version " mtVersion "\n");
+    char* path = NULL;
+    bool printGCStats = false;
+    bool emitC = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--gc-stats") == 0)
+        {
+            printGCStats = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--emit-c") == 0)
+        {
+            emitC = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--jit") == 0)
+        {
+            mtSetJit(true);
+            continue;
+        }
+        if (strcmp(argv[i], "--memoize") == 0)
+        {
+            mtSetMemoization(true);
+            continue;
+        }
+        if (strcmp(argv[i], "--max-depth") == 0)
+        {
+            int64_t depth = 0;
+            if (i + 1 >= argc || mtStringToInt(&depth, argv[i + 1], 10) != mtSuccess || depth <= 0)
+            {
+                mtPrintUsage();
+                return -1;
+            }
+            mtSetMaxCallDepth(depth);
+            i++;
+            continue;
+        }
+
+        if (argv[i][0] == '-' || path != NULL)
+        {
+            mtPrintUsage();
+            return -1;
+        }
+        path = argv[i];
+    }
 
-    if (argc != 2)
+    // the C goes to stdout, so nothing else can.
+    if (!emitC)
     {
-        printf("Usage:\n\t Mint [file]\n");
+        mtOutputPrintf("Mint version " mtVersion "\n");
+    }
+
+    if (path == NULL)
+    {
+        mtPrintUsage();
         return -1;
     }
 
     int result;
-    char* path = argv[1];
 
     // load the file
     size_t fileSize; 
@@ -74,16 +145,25 @@ int main(int argc, char* argv[])
 
     if (result == mtFailOpenFile)
     {
-        printf("Failed to open file %s\n", path);
+        mtOutputPrintf("Failed to open file %s\n", path);
         return mtFailOpenFile; 
     }
 
-    char *fileString = malloc(fileSize); 
+    // +1 for the null-terminator, the tokenizer relies on it.
+    char *fileString = calloc(fileSize + 1, sizeof(char)); 
     if (mtLoadTextFromFile(path, fileString, fileSize) != mtSuccess)
     {
         return mtFail;
     }
     
-    mtExecute(fileString);
+    result = mtExecute(fileString, emitC);
     free(fileString);
+
+    if (printGCStats)
+    {
+        mtOutputFlush();
+        mtGCPrintStats(stderr);
+    }
+
+    return result;
 }
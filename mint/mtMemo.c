@@ -0,0 +1,129 @@
+#include "mtMemo.h"
+
+//@returns true if object's payload is its whole value, a big int's number only points to it.
+static bool isSelfContained(struct mtObject* object)
+{
+    return object->type != &mtNumberType || ((struct mtNumber*)object->data)->type != BIGINT;
+}
+
+bool mtMemoCanKey(struct mtObject** arguments, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!isSelfContained(arguments[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t mtMemoKeySize(struct mtObject** arguments, size_t count)
+{
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        size += sizeof(const struct Type*) + arguments[i]->type->size;
+    }
+    return size;
+}
+
+void mtMemoMakeKey(struct mtMemoKey* key, char* buffer, struct mtObject** arguments, size_t count)
+{
+    char* position = buffer;
+    for (size_t i = 0; i < count; i++)
+    {
+        const struct Type* type = arguments[i]->type;
+
+        memcpy(position, &type, sizeof(const struct Type*));
+        position += sizeof(const struct Type*);
+
+        memcpy(position, arguments[i]->data, type->size);
+        position += type->size;
+    }
+
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+    for (char* c = buffer; c < position; c++)
+    {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+
+    key->hash = hash;
+    key->size = position - buffer;
+    key->bytes = buffer;
+}
+
+static struct mtMemoEntry* getEntry(struct mtMemoTable* table, const struct mtMemoKey* key)
+{
+    return &table->entries[key->hash & (mtMemoCapacity - 1)];
+}
+
+struct mtObject* mtMemoLookup(struct mtMemoTable* table, const struct mtMemoKey* key)
+{
+    if (!table->entries)
+    {
+        return NULL;
+    }
+
+    struct mtMemoEntry* entry = getEntry(table, key);
+    if (!entry->data || entry->keySize != key->size || entry->hash != key->hash || 
+        memcmp(entry->data, key->bytes, key->size) != 0)
+    {
+        return NULL;
+    }
+
+    struct mtObject* out = mtCreateTempObject(entry->resultType);
+    entry->resultType->set(out->data, entry->data + entry->keySize);
+
+    return out;
+}
+
+void mtMemoStore(struct mtMemoTable* table, const struct mtMemoKey* key, struct mtObject* result)
+{
+    // the garbage collector doesn't look in here, so it would free what the payload points to.
+    if (!isSelfContained(result))
+    {
+        return;
+    }
+
+    if (!table->entries)
+    {
+        table->entries = calloc(mtMemoCapacity, sizeof(struct mtMemoEntry));
+        if (!table->entries)
+            return;
+    }
+
+    struct mtMemoEntry* entry = getEntry(table, key);
+    free(entry->data);
+
+    // +1 so functions without parameters still get an entry.
+    entry->data = malloc(key->size + result->type->size + 1);
+    if (!entry->data)
+    {
+        return;
+    }
+
+    memcpy(entry->data, key->bytes, key->size);
+    result->type->set(entry->data + key->size, result->data);
+
+    entry->hash = key->hash;
+    entry->keySize = key->size;
+    entry->resultType = result->type;
+}
+
+void mtMemoClear(struct mtMemoTable* table)
+{
+    if (!table->entries)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < mtMemoCapacity; i++)
+    {
+        free(table->entries[i].data);
+    }
+    free(table->entries);
+    table->entries = NULL;
+}
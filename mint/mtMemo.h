@@ -0,0 +1,56 @@
+
+#ifndef mtMemo_h
+#define mtMemo_h
+
+/*
+*   Result caches for pure functions.
+*
+*   A key is the types and payloads of a call's arguments laid out one after
+*   another, payloads are compared byte for byte, see Type.set in mtObject.h.
+*   Every table has a fixed number of entries and a new result simply
+*   replaces whatever was cached under the same index, so a table never
+*   grows past mtMemoCapacity entries.
+*/
+
+#include <Mint.h>
+
+// entries per function, has to be a power of two.
+#define mtMemoCapacity 1024
+
+struct mtMemoKey {
+    size_t hash;
+    size_t size;
+    char* bytes;
+};
+
+struct mtMemoEntry {
+    size_t hash;
+    size_t keySize;
+
+    const struct Type* resultType;
+    char* data; // the key's bytes, then the result's payload. NULL if the entry is empty
+};
+
+struct mtMemoTable {
+    struct mtMemoEntry* entries; // NULL until the first result is stored
+};
+
+//@returns false if the arguments' payloads don't hold all of their values, ex: big ints.
+bool mtMemoCanKey(struct mtObject** arguments, size_t count);
+
+//@returns how many bytes the key for arguments needs.
+size_t mtMemoKeySize(struct mtObject** arguments, size_t count);
+
+//@brief Writes the key for arguments into buffer, which has to be mtMemoKeySize bytes.
+void mtMemoMakeKey(struct mtMemoKey* key, char* buffer, struct mtObject** arguments, size_t count);
+
+//@returns a temporary copy of the result cached for key, or NULL.
+struct mtObject* mtMemoLookup(struct mtMemoTable* table, const struct mtMemoKey* key);
+
+//@brief Caches a copy of result under key.
+void mtMemoStore(struct mtMemoTable* table, const struct mtMemoKey* key, struct mtObject* result);
+
+//@brief Forgets every result in table.
+void mtMemoClear(struct mtMemoTable* table);
+
+#endif
@@ -0,0 +1,306 @@
+
+#include "mtOptimize.h"
+
+#include <Mint.h>
+
+static bool isIntegerLiteral(struct ASTNode* node, int value)
+{
+    if (node->type != NodeType_Number || node->token.type != TokenType_IntegerLiteral)
+    {
+        return false;
+    }
+
+    struct mtNumber number;
+    mtInterpretInteger(&node->token, &number);
+    return number.type == INTEGER && number.integer == value;
+}
+
+static bool isNumber(struct ASTNode* node)
+{
+    return node->inferred != Inferred_None;
+}
+
+static bool isInteger(struct ASTNode* node)
+{
+    return node->inferred == Inferred_Integer;
+}
+
+//@returns the operand node is the same as, or NULL.
+static struct ASTNode* findIdentity(struct ASTNode* node)
+{
+    struct ASTNode* left = node->children[0];
+    struct ASTNode* right = node->children[1];
+
+    switch (node->token.type)
+    {
+        case TokenType_OperatorMultiplication:
+            if (isIntegerLiteral(right, 1) && isNumber(left))
+            {
+                return left;
+            }
+            if (isIntegerLiteral(left, 1) && isNumber(right))
+            {
+                return right;
+            }
+            break;
+
+        case TokenType_OperatorAddition:
+            if (isIntegerLiteral(right, 0) && isInteger(left))
+            {
+                return left;
+            }
+            if (isIntegerLiteral(left, 0) && isInteger(right))
+            {
+                return right;
+            }
+            break;
+
+        case TokenType_OperatorSubtraction:
+            if (isIntegerLiteral(right, 0) && isNumber(left))
+            {
+                return left;
+            }
+            break;
+
+        case TokenType_OperatorDivision:
+            if (isIntegerLiteral(right, 1) && isInteger(left))
+            {
+                return left;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return NULL;
+}
+
+//@brief Removes the identities in node.
+//
+//@param isArgument node is passed to a function.
+//
+//@returns what replaces node, which is freed if it's not node itself.
+static struct ASTNode* simplify(struct ASTNode* node, bool isArgument)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        node->children[i] = simplify(node->children[i], node->type == NodeType_ArgumentList);
+    }
+
+    if (node->type != NodeType_BinaryOperator || node->childCount != 2)
+    {
+        return node;
+    }
+
+    struct ASTNode* operand = findIdentity(node);
+    if (!operand)
+    {
+        return node;
+    }
+
+    // arguments are only copied if they're computed.
+    if (isArgument && operand->type != NodeType_BinaryOperator && 
+        operand->type != NodeType_Number && operand->type != NodeType_Constant)
+    {
+        return node;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        if (node->children[i] == operand)
+        {
+            node->children[i] = NULL;
+        }
+    }
+    mtASTFree(node);
+
+    return operand;
+}
+
+static bool tokenEquals(struct Token a, struct Token b)
+{
+    return a.size == b.size && memcmp(a.string, b.string, a.size) == 0;
+}
+
+//@returns true if node is only literals, variables and arithmetic.
+static bool canShare(struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return false;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Number:
+        case NodeType_Constant:
+        case NodeType_Identifier:
+            return true;
+        case NodeType_BinaryOperator:
+            return node->childCount == 2 && canShare(node->children[0]) && canShare(node->children[1]);
+        default:
+            return false;
+    }
+}
+
+static bool hasCalls(struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return false;
+    }
+    if (node->type == NodeType_FunctionCall)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        if (hasCalls(node->children[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isSameExpression(struct ASTNode* a, struct ASTNode* b)
+{
+    if (a->type != b->type || a->token.type != b->token.type ||
+        !tokenEquals(a->token, b->token) || a->childCount != b->childCount)
+    {
+        return false;
+    }
+    // set through numberSet, so equal values have equal bytes.
+    if (a->type == NodeType_Constant && memcmp(&a->constant, &b->constant, sizeof(struct mtNumber)) != 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < a->childCount; i++)
+    {
+        if (!isSameExpression(a->children[i], b->children[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the operators in a statement that were already evaluated by the time the current one is.
+struct Evaluated {
+    struct ASTNode** nodes;
+    size_t count;
+    size_t capacity;
+};
+
+//@brief Points the operators in node at earlier ones which compute the same.
+static void shareResults(struct ASTNode* node, struct Evaluated* evaluated)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    bool isShareable = node->type == NodeType_BinaryOperator && canShare(node);
+    if (isShareable)
+    {
+        for (size_t i = 0; i < evaluated->count; i++)
+        {
+            if (isSameExpression(evaluated->nodes[i], node))
+            {
+                // none of what's under node is evaluated anymore.
+                node->sameAs = evaluated->nodes[i];
+                evaluated->nodes[i]->keepsResult = true;
+                return;
+            }
+        }
+    }
+
+    // operands are evaluated left to right before their operator.
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        shareResults(node->children[i], evaluated);
+    }
+
+    if (isShareable)
+    {
+        if (evaluated->count >= evaluated->capacity)
+        {
+            evaluated->capacity = evaluated->capacity ? evaluated->capacity * 2 : 8;
+            evaluated->nodes = realloc(evaluated->nodes, sizeof(struct ASTNode*) * evaluated->capacity);
+        }
+        evaluated->nodes[evaluated->count++] = node;
+    }
+}
+
+static void shareInStatement(struct ASTNode* expression)
+{
+    if (expression == NULL || hasCalls(expression))
+    {
+        return;
+    }
+
+    struct Evaluated evaluated = { NULL, 0, 0 };
+    shareResults(expression, &evaluated);
+    free(evaluated.nodes);
+}
+
+//@brief Finds every block in node and shares the results in its statements.
+static void shareInBlocks(struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    if (node->type == NodeType_Block)
+    {
+        for (size_t i = 0; i < node->childCount; i++)
+        {
+            struct ASTNode* statement = node->children[i];
+            if (statement == NULL)
+            {
+                continue;
+            }
+
+            switch (statement->type)
+            {
+                case NodeType_Assignment:
+                    if (statement->childCount > 1)
+                    {
+                        shareInStatement(statement->children[1]);
+                    }
+                    break;
+                case NodeType_IfStatement:
+                case NodeType_WhileLoop:
+                    if (statement->childCount > 0)
+                    {
+                        shareInStatement(statement->children[0]);
+                    }
+                    break;
+                case NodeType_BinaryOperator:
+                    shareInStatement(statement);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        shareInBlocks(node->children[i]);
+    }
+}
+
+void mtOptimize(struct ASTNode* root)
+{
+    root = simplify(root, false);
+    shareInBlocks(root);
+}
@@ -0,0 +1,25 @@
+
+#ifndef mtOptimize_h
+#define mtOptimize_h
+
+/*
+*   Rewrites the program so it does less work, without changing what it does.
+*
+*   Identities are removed where the result is exactly the same number:
+*   x * 1 and x - 0 always, x + 0 and x / 1 only for ints, since -0.0 + 0
+*   is 0.0 and 3.0 / 1 is the int 3. An argument is never reduced to just a
+*   variable, which would pass the variable by reference instead of a copy.
+*
+*   Binary operators which compute the same as an earlier one in the same
+*   statement reuse its result, ex: the second a * b in (a * b) + (a * b) / c.
+*   Only statements without calls are looked at, a call could change the
+*   variables in between, and only within a statement since every statement
+*   frees its temporaries once it's done.
+*/
+
+#include "mtAST.h"
+
+//@brief Optimizes root, which has to be the whole program with its types inferred, see mtInfer.h
+void mtOptimize(struct ASTNode* root);
+
+#endif
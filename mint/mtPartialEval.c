@@ -0,0 +1,394 @@
+
+#include "mtPartialEval.h"
+
+#include <Mint.h>
+
+#include "mtBigInt.h"
+#include "mtFunction.h"
+
+struct Definition {
+    struct ASTNode* node;
+
+    // the top level statement it is, only those are always defined once they've run.
+    size_t statement;
+    bool isTopLevel;
+
+    bool isAmbiguous; // it's defined more than once, calls to it are left alone
+};
+
+struct Evaluation {
+    struct mtHashMap* definitions; // struct Definition* by function name
+
+    // the top level statement the call being evaluated is in.
+    size_t statement;
+
+    size_t steps;
+    size_t depth;
+    size_t maxDepth;
+};
+
+// the arguments of the call whose body is being evaluated.
+struct Frame {
+    struct ASTNode* parameterList;
+    struct mtNumber* arguments;
+};
+
+static bool tokenEquals(struct Token a, struct Token b)
+{
+    return a.size == b.size && memcmp(a.string, b.string, a.size) == 0;
+}
+
+//@brief Finds every function definition in node, by name.
+static void collectDefinitions(struct mtHashMap* definitions, struct ASTNode* node, size_t statement, bool isTopLevel)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    if (node->type == NodeType_FunctionDefinition && node->childCount >= 3)
+    {
+        struct Token token = node->children[0]->token;
+        char name[token.size + 1];
+        mtGetTokenString(token, (char*)&name, token.size);
+
+        struct Definition* definition = mtHashMapGet(definitions, name);
+        if (definition)
+        {
+            definition->isAmbiguous = true;
+        } else {
+            definition = calloc(1, sizeof(struct Definition));
+            definition->node = node;
+            definition->statement = statement;
+            definition->isTopLevel = isTopLevel;
+            mtHashMapPut(definitions, name, definition);
+        }
+    }
+
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        collectDefinitions(definitions, node->children[i], statement, false);
+    }
+}
+
+static bool evaluateCall(struct Evaluation* evaluation, struct Token identifier,
+                         struct mtNumber* arguments, size_t argumentCount, struct mtNumber* out);
+
+//@brief Evaluates an expression in the body of frame's call, frame is NULL for its arguments.
+//
+//@returns false if it can't be evaluated yet, out is left undefined then.
+static bool evaluate(struct Evaluation* evaluation, struct ASTNode* node, struct Frame* frame, struct mtNumber* out)
+{
+    if (node == NULL || ++evaluation->steps > mtPartialEvalMaxSteps)
+    {
+        return false;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_Number:
+        {
+            // the same as intepretInteger and interpretDecimal in mtExpression.c
+            struct mtNumber number;
+            if (node->token.type == TokenType_IntegerLiteral)
+            {
+                mtInterpretInteger(&node->token, &number);
+            } else {
+                number.type = DECIMAL;
+                number.decimal = mtInterpretDecimal(&node->token);
+            }
+            numberSet(out, &number);
+            return true;
+        }
+
+        case NodeType_Constant:
+            numberSet(out, &node->constant);
+            return true;
+
+        case NodeType_Identifier:
+            // anything but a parameter is a variable of the program.
+            for (size_t i = 0; frame && i < frame->parameterList->childCount; i++)
+            {
+                if (tokenEquals(node->token, frame->parameterList->children[i]->token))
+                {
+                    numberSet(out, &frame->arguments[i]);
+                    return true;
+                }
+            }
+            return false;
+
+        case NodeType_BinaryOperator:
+        {
+            struct mtNumber left, right, number;
+            if (node->childCount != 2 ||
+                !evaluate(evaluation, node->children[0], frame, &left) ||
+                !evaluate(evaluation, node->children[1], frame, &right))
+            {
+                return false;
+            }
+
+            switch (node->token.type)
+            {
+                case TokenType_OperatorAddition:
+                    numberAdd(&number, &left, &right);
+                    break;
+                case TokenType_OperatorSubtraction:
+                    numberSub(&number, &left, &right);
+                    break;
+                case TokenType_OperatorMultiplication:
+                    numberMul(&number, &left, &right);
+                    break;
+                case TokenType_OperatorDivision:
+                    // the program prints the error itself.
+                    if ((right.type == INTEGER && right.integer == 0) ||
+                        (right.type == DECIMAL && right.decimal == 0.0))
+                    {
+                        return false;
+                    }
+                    numberDiv(&number, &left, &right);
+                    break;
+                default:
+                    return false;
+            }
+            numberSet(out, &number);
+            return true;
+        }
+
+        case NodeType_FunctionCall:
+        {
+            if (node->childCount != 2)
+            {
+                return false;
+            }
+
+            struct ASTNode* argumentList = node->children[1];
+            struct mtNumber arguments[argumentList->childCount + 1];
+            for (size_t i = 0; i < argumentList->childCount; i++)
+            {
+                if (!evaluate(evaluation, argumentList->children[i], frame, &arguments[i]))
+                {
+                    return false;
+                }
+            }
+            return evaluateCall(evaluation, node->children[0]->token, arguments, argumentList->childCount, out);
+        }
+
+        default:
+            return false;
+    }
+}
+
+//@brief Evaluates a comparison, like interpretConditional in mtIfStatement.c
+static bool evaluateCondition(struct Evaluation* evaluation, struct ASTNode* node, struct Frame* frame, bool* out)
+{
+    struct mtNumber left, right;
+    if (node->childCount < 2 ||
+        !evaluate(evaluation, node->children[0], frame, &left) ||
+        !evaluate(evaluation, node->children[1], frame, &right))
+    {
+        return false;
+    }
+
+    switch (node->type)
+    {
+        case NodeType_GreaterThan:
+            *out = mtNumberIsGreater(&left, &right);
+            return true;
+        case NodeType_LesserThan:
+            *out = mtNumberIsLesser(&left, &right);
+            return true;
+        case NodeType_GreaterThanOrEqual:
+            *out = mtNumberIsGreater(&left, &right) || mtNumberIsEqual(&left, &right);
+            return true;
+        case NodeType_LesserThanOrEqual:
+            *out = mtNumberIsLesser(&left, &right) || mtNumberIsEqual(&left, &right);
+            return true;
+        case NodeType_IsEqual:
+            *out = mtNumberIsEqual(&left, &right);
+            return true;
+        case NodeType_IsNotEqual:
+            *out = !mtNumberIsEqual(&left, &right);
+            return true;
+        default:
+            return false;
+    }
+}
+
+//@brief Evaluates the statements in block, like interpretStatements in mtBlock.c
+//
+//@param hasResult set if one of the statements had a result, which is then in out.
+static bool evaluateStatements(struct Evaluation* evaluation, struct ASTNode* block, struct Frame* frame,
+                               struct mtNumber* out, bool* hasResult)
+{
+    for (size_t i = 0; i < block->childCount; i++)
+    {
+        struct ASTNode* statement = block->children[i];
+        if (statement == NULL)
+        {
+            return false;
+        }
+
+        switch (statement->type)
+        {
+            case NodeType_IfStatement:
+            {
+                bool conditional = false;
+                if (statement->childCount < 2 || !evaluateCondition(evaluation, statement->children[0], frame, &conditional))
+                {
+                    return false;
+                }
+                if (conditional && !evaluateStatements(evaluation, statement->children[1], frame, out, hasResult))
+                {
+                    return false;
+                }
+                break;
+            }
+
+            case NodeType_BinaryOperator:
+            case NodeType_FunctionCall:
+            case NodeType_Identifier:
+            case NodeType_Number:
+            case NodeType_Constant:
+                // the result before this one would be printed.
+                if (*hasResult || !evaluate(evaluation, statement, frame, out))
+                {
+                    return false;
+                }
+                *hasResult = true;
+                break;
+
+            // they change the program's variables or functions.
+            case NodeType_Assignment:
+            case NodeType_WhileLoop:
+            case NodeType_ForLoop:
+            case NodeType_FunctionDefinition:
+                return false;
+
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+//@brief Evaluates a call to the function named identifier.
+static bool evaluateCall(struct Evaluation* evaluation, struct Token identifier,
+                         struct mtNumber* arguments, size_t argumentCount, struct mtNumber* out)
+{
+    char name[identifier.size + 1];
+    mtGetTokenString(identifier, (char*)&name, identifier.size);
+
+    struct Definition* definition = mtHashMapGet(evaluation->definitions, name);
+    if (!definition || definition->isAmbiguous || !definition->isTopLevel ||
+        definition->statement >= evaluation->statement)
+    {
+        return false;
+    }
+
+    struct ASTNode* parameterList = definition->node->children[1];
+    if (parameterList->childCount != argumentCount || evaluation->depth >= evaluation->maxDepth)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < argumentCount; i++)
+    {
+        struct ASTNode* parameter = parameterList->children[i];
+        if (parameter->childCount == 0)
+        {
+            continue;
+        }
+
+        struct Parameter hint;
+        int type = mtNumberIsInteger(&arguments[i]) ? INTEGER : DECIMAL;
+        if (!mtResolveTypeHint(&hint, parameter->children[0]) || type != hint.numberType)
+        {
+            return false;
+        }
+    }
+
+    struct Frame frame = { parameterList, arguments };
+    bool hasResult = false;
+
+    evaluation->depth++;
+    bool evaluated = evaluateStatements(evaluation, definition->node->children[2], &frame, out, &hasResult);
+    evaluation->depth--;
+
+    return evaluated && hasResult;
+}
+
+//@brief Replaces the calls in node which only have literal arguments by what they evaluate to.
+static void foldCalls(struct Evaluation* evaluation, struct ASTNode* node)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    // calls in the arguments are folded first, so their call can be too.
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        foldCalls(evaluation, node->children[i]);
+    }
+
+    if (node->type != NodeType_FunctionCall || node->childCount != 2)
+    {
+        return;
+    }
+
+    struct ASTNode* argumentList = node->children[1];
+    struct mtNumber arguments[argumentList->childCount + 1];
+    evaluation->steps = 0;
+    evaluation->depth = 0;
+
+    for (size_t i = 0; i < argumentList->childCount; i++)
+    {
+        enum NodeType type = argumentList->children[i]->type;
+        if (type != NodeType_Number && type != NodeType_Constant)
+        {
+            return;
+        }
+        evaluate(evaluation, argumentList->children[i], NULL, &arguments[i]);
+    }
+
+    struct mtNumber result;
+    if (!evaluateCall(evaluation, node->children[0]->token, arguments, argumentList->childCount, &result))
+    {
+        return;
+    }
+
+    // a constant isn't seen by the garbage collector, so its big int is kept for good.
+    if (result.type == BIGINT)
+    {
+        mtBigIntKeep(result.big);
+    }
+
+    // the call's token stays for errors, see mtParser.c
+    for (size_t i = 0; i < node->childCount; i++)
+    {
+        mtASTFree(node->children[i]);
+    }
+    node->childCount = 0;
+    node->type = NodeType_Constant;
+    numberSet(&node->constant, &result);
+}
+
+void mtPartialEvaluate(struct ASTNode* root)
+{
+    struct Evaluation evaluation;
+    evaluation.definitions = mtHashMapCreate(64);
+    evaluation.maxDepth = mtGetMaxCallDepth() < mtPartialEvalMaxDepth ? mtGetMaxCallDepth() : mtPartialEvalMaxDepth;
+
+    for (size_t i = 0; i < root->childCount; i++)
+    {
+        collectDefinitions(evaluation.definitions, root->children[i], i, true);
+    }
+
+    for (size_t i = 0; i < root->childCount; i++)
+    {
+        evaluation.statement = i;
+        foldCalls(&evaluation, root->children[i]);
+    }
+
+    mtHashMapDestroy(evaluation.definitions, &free);
+}
@@ -0,0 +1,33 @@
+
+#ifndef mtPartialEval_h
+#define mtPartialEval_h
+
+/*
+*   Works out calls to pure functions whose arguments are all literals before
+*   the program runs, ex: the fib(20) in x = fib(20) becomes the number it
+*   returns, a NodeType_Constant.
+*
+*   The function has to be defined once in the whole program, by a statement
+*   at the top level that comes before the one the call is in, so the call
+*   can't reach anything else. Its body, and the bodies of the functions it
+*   calls, can only read their parameters, do arithmetic, compare and call
+*   other such functions, so running it can't print or change a variable.
+*
+*   Anything which would have gone wrong when the call ran, like a division
+*   by zero or a type hint that doesn't fit, leaves the call as it is, so the
+*   error is still printed from where it happens. So do calls which take more
+*   than mtPartialEvalMaxSteps nodes or nest deeper than mtPartialEvalMaxDepth.
+*/
+
+#include "mtAST.h"
+
+// nodes evaluated for a single call, bigger ones are left for the program to run.
+#define mtPartialEvalMaxSteps 100000
+
+// calls nested in a single call, see mtSetMaxCallDepth for the program's own limit.
+#define mtPartialEvalMaxDepth 1000
+
+//@brief Replaces the calls in root that can be evaluated already, it has to be the whole program.
+void mtPartialEvaluate(struct ASTNode* root);
+
+#endif
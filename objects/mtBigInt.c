@@ -0,0 +1,604 @@
+
+#include "mtBigInt.h"
+#include "mtNumberObject.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// every big int that wasn't swept yet, linked through mtBigInt.next
+static struct mtBigInt* bigInts = NULL;
+
+static size_t allocatedSinceSweep = 0;
+
+// the magnitude and sign of an int of either size.
+struct Magnitude {
+    const uint32_t* limbs;
+    size_t count;
+    bool negative;
+
+    uint32_t small[2]; // the limbs of a plain integer
+};
+
+static size_t trim(const uint32_t* limbs, size_t count)
+{
+    while (count > 0 && limbs[count - 1] == 0)
+    {
+        count--;
+    }
+    return count;
+}
+
+//@brief Points magnitude at number's limbs, magnitude can't be copied afterwards.
+static void getMagnitude(struct Magnitude* magnitude, const struct mtNumber* number)
+{
+    if (number->type == BIGINT)
+    {
+        magnitude->limbs = number->big->limbs;
+        magnitude->count = number->big->count;
+        magnitude->negative = number->big->negative;
+        return;
+    }
+
+    // negated as unsigned, so INT64_MIN has a magnitude too.
+    uint64_t value = number->integer < 0 ? 0 - (uint64_t)number->integer : (uint64_t)number->integer;
+    magnitude->small[0] = (uint32_t)value;
+    magnitude->small[1] = (uint32_t)(value >> 32);
+    magnitude->limbs = magnitude->small;
+    magnitude->count = trim(magnitude->small, 2);
+    magnitude->negative = number->integer < 0;
+}
+
+//@brief Sets out to the int with limbs as its magnitude, a plain integer if it fits in one.
+static void setResult(struct mtNumber* out, const uint32_t* limbs, size_t count, bool negative)
+{
+    count = trim(limbs, count);
+
+    struct mtNumber result;
+    memset(&result, 0, sizeof(struct mtNumber));
+
+    uint64_t value = 0;
+    if (count <= 2)
+    {
+        value = count > 0 ? limbs[0] : 0;
+        value |= count > 1 ? (uint64_t)limbs[1] << 32 : 0;
+    }
+
+    if (count <= 2 && value <= (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX))
+    {
+        result.type = INTEGER;
+        result.integer = negative ? (int64_t)(0 - value) : (int64_t)value;
+    } else {
+        size_t size = sizeof(struct mtBigInt) + sizeof(uint32_t) * count;
+        struct mtBigInt* big = malloc(size);
+        big->next = bigInts;
+        big->marked = false;
+        big->kept = false;
+        big->negative = negative;
+        big->count = count;
+        memcpy(big->limbs, limbs, sizeof(uint32_t) * count);
+
+        bigInts = big;
+        allocatedSinceSweep += size;
+
+        result.type = BIGINT;
+        result.big = big;
+    }
+
+    memcpy(out, &result, sizeof(struct mtNumber));
+}
+
+static int compareMagnitudes(const uint32_t* a, size_t aCount, const uint32_t* b, size_t bCount)
+{
+    if (aCount != bCount)
+    {
+        return aCount < bCount ? -1 : 1;
+    }
+    for (size_t i = aCount; i > 0; i--)
+    {
+        if (a[i - 1] != b[i - 1])
+        {
+            return a[i - 1] < b[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+//@brief dst += src, dst has to have at least as many limbs as src.
+//
+//@returns the carry out of dst.
+static uint32_t addInto(uint32_t* dst, size_t dstCount, const uint32_t* src, size_t srcCount)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < dstCount && (i < srcCount || carry); i++)
+    {
+        uint64_t sum = (uint64_t)dst[i] + (i < srcCount ? src[i] : 0) + carry;
+        dst[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    return (uint32_t)carry;
+}
+
+//@brief dst -= src, dst has to have at least as many limbs as src.
+//
+//@returns the borrow out of dst, 0 if dst was at least src.
+static uint32_t subtractInto(uint32_t* dst, size_t dstCount, const uint32_t* src, size_t srcCount)
+{
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < dstCount && (i < srcCount || borrow); i++)
+    {
+        uint64_t difference = (uint64_t)dst[i] - (i < srcCount ? src[i] : 0) - borrow;
+        dst[i] = (uint32_t)difference;
+        borrow = (difference >> 32) ? 1 : 0;
+    }
+    return (uint32_t)borrow;
+}
+
+//@brief out = a + b, out has aCount + 1 limbs and aCount is at least bCount.
+static void addMagnitudes(uint32_t* out, const uint32_t* a, size_t aCount, const uint32_t* b, size_t bCount)
+{
+    memcpy(out, a, sizeof(uint32_t) * aCount);
+    out[aCount] = addInto(out, aCount, b, bCount);
+}
+
+//@brief out = a * b, out has aCount + bCount limbs which are all overwritten.
+static void multiplySchoolbook(uint32_t* out, const uint32_t* a, size_t aCount, const uint32_t* b, size_t bCount)
+{
+    memset(out, 0, sizeof(uint32_t) * (aCount + bCount));
+    for (size_t i = 0; i < aCount; i++)
+    {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < bCount; j++)
+        {
+            uint64_t product = (uint64_t)a[i] * b[j] + out[i + j] + carry;
+            out[i + j] = (uint32_t)product;
+            carry = product >> 32;
+        }
+        out[i + bCount] = (uint32_t)carry;
+    }
+}
+
+//@brief out = a * b, out has aCount + bCount limbs which are all overwritten.
+static void multiply(uint32_t* out, const uint32_t* a, size_t aCount, const uint32_t* b, size_t bCount)
+{
+    if (aCount < bCount)
+    {
+        const uint32_t* limbs = a; a = b; b = limbs;
+        size_t count = aCount; aCount = bCount; bCount = count;
+    }
+
+    if (bCount < mtBigIntKaratsubaThreshold)
+    {
+        multiplySchoolbook(out, a, aCount, b, bCount);
+        return;
+    }
+
+    size_t half = (aCount + 1) / 2;
+    size_t aHigh = aCount - half;
+
+    // b is too short to be split as well, both halves of a are multiplied by all of it.
+    if (bCount <= half)
+    {
+        uint32_t* high = malloc(sizeof(uint32_t) * (aHigh + bCount));
+        multiply(out, a, half, b, bCount);
+        memset(out + half + bCount, 0, sizeof(uint32_t) * aHigh);
+        multiply(high, a + half, aHigh, b, bCount);
+        addInto(out + half, aCount + bCount - half, high, aHigh + bCount);
+        free(high);
+        return;
+    }
+    size_t bHigh = bCount - half;
+
+    // a * b = high << 2 * half + (middle - high - low) << half + low,
+    // where middle = (aLow + aHigh) * (bLow + bHigh)
+    multiply(out, a, half, b, half);
+    multiply(out + 2 * half, a + half, aHigh, b + half, bHigh);
+
+    uint32_t* scratch = malloc(sizeof(uint32_t) * 4 * (half + 1));
+    uint32_t* aSum = scratch;
+    uint32_t* bSum = aSum + half + 1;
+    uint32_t* middle = bSum + half + 1;
+
+    addMagnitudes(aSum, a, half, a + half, aHigh);
+    addMagnitudes(bSum, b, half, b + half, bHigh);
+    multiply(middle, aSum, half + 1, bSum, half + 1);
+
+    subtractInto(middle, 2 * half + 2, out, 2 * half);
+    subtractInto(middle, 2 * half + 2, out + 2 * half, aHigh + bHigh);
+    addInto(out + half, aCount + bCount - half, middle, trim(middle, 2 * half + 2));
+
+    free(scratch);
+}
+
+//@brief quotient = a / divisor, quotient has aCount limbs.
+//
+//@returns the remainder.
+static uint32_t divideSmall(uint32_t* quotient, const uint32_t* a, size_t aCount, uint32_t divisor)
+{
+    uint64_t remainder = 0;
+    for (size_t i = aCount; i > 0; i--)
+    {
+        uint64_t current = (remainder << 32) | a[i - 1];
+        quotient[i - 1] = (uint32_t)(current / divisor);
+        remainder = current % divisor;
+    }
+    return (uint32_t)remainder;
+}
+
+//@brief a = a * factor + addend, a has count limbs.
+//
+//@returns the carry out of a.
+static uint32_t multiplyAddSmall(uint32_t* a, size_t count, uint32_t factor, uint32_t addend)
+{
+    uint64_t carry = addend;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t product = (uint64_t)a[i] * factor + carry;
+        a[i] = (uint32_t)product;
+        carry = product >> 32;
+    }
+    return (uint32_t)carry;
+}
+
+//@brief Long division, algorithm D from Knuth's The Art of Computer Programming vol. 2
+// a is at least b, which has at least 2 limbs.
+// quotient has aCount - bCount + 1 limbs, remainder has bCount.
+static void divideMagnitudes(uint32_t* quotient, uint32_t* remainder,
+                             const uint32_t* a, size_t aCount, const uint32_t* b, size_t bCount)
+{
+    // shifted so b's top limb has its top bit set, which keeps the estimates close.
+    int shift = __builtin_clz(b[bCount - 1]);
+
+    uint32_t* v = malloc(sizeof(uint32_t) * bCount);
+    uint32_t* u = malloc(sizeof(uint32_t) * (aCount + 1));
+
+    for (size_t i = bCount - 1; i > 0; i--)
+    {
+        v[i] = (b[i] << shift) | (shift ? b[i - 1] >> (32 - shift) : 0);
+    }
+    v[0] = b[0] << shift;
+
+    u[aCount] = shift ? a[aCount - 1] >> (32 - shift) : 0;
+    for (size_t i = aCount - 1; i > 0; i--)
+    {
+        u[i] = (a[i] << shift) | (shift ? a[i - 1] >> (32 - shift) : 0);
+    }
+    u[0] = a[0] << shift;
+
+    for (size_t j = aCount - bCount + 1; j > 0; j--)
+    {
+        size_t k = j - 1;
+
+        // estimate the next limb of the quotient from the top limbs, it's at most 2 too big.
+        uint64_t top = ((uint64_t)u[k + bCount] << 32) | u[k + bCount - 1];
+        uint64_t estimate = top / v[bCount - 1];
+        uint64_t rest = top % v[bCount - 1];
+        while (estimate > UINT32_MAX ||
+               estimate * v[bCount - 2] > ((rest << 32) | u[k + bCount - 2]))
+        {
+            estimate--;
+            rest += v[bCount - 1];
+            if (rest > UINT32_MAX)
+            {
+                break;
+            }
+        }
+
+        // u -= estimate * v, shifted by k limbs.
+        int64_t borrow = 0;
+        for (size_t i = 0; i < bCount; i++)
+        {
+            uint64_t product = estimate * v[i];
+            int64_t difference = (int64_t)u[i + k] - borrow - (int64_t)(product & UINT32_MAX);
+            u[i + k] = (uint32_t)difference;
+            borrow = (int64_t)(product >> 32) - (difference >> 32);
+        }
+        int64_t difference = (int64_t)u[k + bCount] - borrow;
+        u[k + bCount] = (uint32_t)difference;
+
+        // it was 1 too big after all, so v is added back.
+        if (difference < 0)
+        {
+            estimate--;
+            u[k + bCount] += addInto(u + k, bCount, v, bCount);
+        }
+        quotient[k] = (uint32_t)estimate;
+    }
+
+    for (size_t i = 0; i < bCount; i++)
+    {
+        remainder[i] = (u[i] >> shift) | (shift ? u[i + 1] << (32 - shift) : 0);
+    }
+
+    free(u);
+    free(v);
+}
+
+//@returns the magnitude as the returned value * 2^(32 * exponent), from its top 3 limbs.
+static double toScaledDouble(const uint32_t* limbs, size_t count, long* exponent)
+{
+    size_t first = count > 3 ? count - 3 : 0;
+    double out = 0;
+    for (size_t i = count; i > first; i--)
+    {
+        out = out * 4294967296.0 + limbs[i - 1];
+    }
+    *exponent = (long)first;
+    return out;
+}
+
+//@brief out = x + y
+static void addSigned(struct mtNumber* out, const struct Magnitude* x, const struct Magnitude* y)
+{
+    const struct Magnitude* longer = x->count >= y->count ? x : y;
+    const struct Magnitude* shorter = x->count >= y->count ? y : x;
+    uint32_t* limbs = malloc(sizeof(uint32_t) * (longer->count + 1));
+
+    if (x->negative == y->negative)
+    {
+        addMagnitudes(limbs, longer->limbs, longer->count, shorter->limbs, shorter->count);
+        setResult(out, limbs, longer->count + 1, x->negative);
+    } else {
+        // the smaller magnitude is taken from the bigger one, which decides the sign.
+        bool isYBigger = compareMagnitudes(x->limbs, x->count, y->limbs, y->count) < 0;
+        longer = isYBigger ? y : x;
+        shorter = isYBigger ? x : y;
+
+        memcpy(limbs, longer->limbs, sizeof(uint32_t) * longer->count);
+        subtractInto(limbs, longer->count, shorter->limbs, shorter->count);
+        setResult(out, limbs, longer->count, longer->negative);
+    }
+
+    free(limbs);
+}
+
+void mtBigIntAdd(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b)
+{
+    struct Magnitude x, y;
+    getMagnitude(&x, a);
+    getMagnitude(&y, b);
+
+    addSigned(out, &x, &y);
+}
+
+void mtBigIntSub(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b)
+{
+    struct Magnitude x, y;
+    getMagnitude(&x, a);
+    getMagnitude(&y, b);
+
+    y.negative = !y.negative;
+    addSigned(out, &x, &y);
+}
+
+void mtBigIntMul(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b)
+{
+    struct Magnitude x, y;
+    getMagnitude(&x, a);
+    getMagnitude(&y, b);
+
+    if (x.count == 0 || y.count == 0)
+    {
+        setResult(out, NULL, 0, false);
+        return;
+    }
+
+    uint32_t* limbs = malloc(sizeof(uint32_t) * (x.count + y.count));
+    multiply(limbs, x.limbs, x.count, y.limbs, y.count);
+    setResult(out, limbs, x.count + y.count, x.negative != y.negative);
+    free(limbs);
+}
+
+void mtBigIntDiv(struct mtNumber* out, const struct mtNumber* a, const struct mtNumber* b)
+{
+    struct Magnitude x, y;
+    getMagnitude(&x, a);
+    getMagnitude(&y, b);
+
+    bool negative = x.negative != y.negative;
+    uint32_t* quotient = malloc(sizeof(uint32_t) * (x.count + 1));
+    uint32_t* remainder = malloc(sizeof(uint32_t) * (y.count + 1));
+    size_t quotientCount = 0;
+    size_t remainderCount = 0;
+
+    if (compareMagnitudes(x.limbs, x.count, y.limbs, y.count) < 0)
+    {
+        memcpy(remainder, x.limbs, sizeof(uint32_t) * x.count);
+        remainderCount = x.count;
+    }
+    else if (y.count == 1)
+    {
+        remainder[0] = divideSmall(quotient, x.limbs, x.count, y.limbs[0]);
+        quotientCount = x.count;
+        remainderCount = 1;
+    } else {
+        divideMagnitudes(quotient, remainder, x.limbs, x.count, y.limbs, y.count);
+        quotientCount = x.count - y.count + 1;
+        remainderCount = y.count;
+    }
+    remainderCount = trim(remainder, remainderCount);
+
+    if (remainderCount == 0)
+    {
+        setResult(out, quotient, quotientCount, negative);
+    } else {
+        // quotient + remainder / b, each scaled so neither overflows a double on its own.
+        long quotientExponent, remainderExponent, divisorExponent;
+        double whole = toScaledDouble(quotient, trim(quotient, quotientCount), &quotientExponent);
+        double part = toScaledDouble(remainder, remainderCount, &remainderExponent);
+        double divisor = toScaledDouble(y.limbs, y.count, &divisorExponent);
+
+        double value = ldexp(whole, 32 * quotientExponent) +
+                       ldexp(part / divisor, 32 * (remainderExponent - divisorExponent));
+
+        struct mtNumber result;
+        memset(&result, 0, sizeof(struct mtNumber));
+        result.type = DECIMAL;
+        result.decimal = negative ? -value : value;
+        memcpy(out, &result, sizeof(struct mtNumber));
+    }
+
+    free(quotient);
+    free(remainder);
+}
+
+int mtBigIntCompare(const struct mtNumber* a, const struct mtNumber* b)
+{
+    struct Magnitude x, y;
+    getMagnitude(&x, a);
+    getMagnitude(&y, b);
+
+    if (x.negative != y.negative)
+    {
+        return x.negative ? -1 : 1;
+    }
+
+    int out = compareMagnitudes(x.limbs, x.count, y.limbs, y.count);
+    return x.negative ? -out : out;
+}
+
+double mtBigIntToDouble(const struct mtNumber* a)
+{
+    if (a->type != BIGINT)
+    {
+        return (double)a->integer;
+    }
+
+    long exponent;
+    double value = toScaledDouble(a->big->limbs, a->big->count, &exponent);
+    value = ldexp(value, 32 * exponent);
+    return a->big->negative ? -value : value;
+}
+
+size_t mtBigIntStr(const struct mtBigInt* big, char* out, size_t size)
+{
+    // the digits come out 9 at a time, least significant first.
+    size_t chunkCapacity = big->count * 32 / 29 + 2;
+    uint32_t* chunks = malloc(sizeof(uint32_t) * chunkCapacity);
+    size_t chunkCount = 0;
+
+    uint32_t* rest = malloc(sizeof(uint32_t) * big->count);
+    memcpy(rest, big->limbs, sizeof(uint32_t) * big->count);
+    size_t restCount = big->count;
+
+    while (restCount > 0)
+    {
+        chunks[chunkCount++] = divideSmall(rest, rest, restCount, 1000000000);
+        restCount = trim(rest, restCount);
+    }
+    free(rest);
+
+    size_t topDigits = 1;
+    for (uint32_t top = chunks[chunkCount - 1]; top >= 10; top /= 10)
+    {
+        topDigits++;
+    }
+    size_t length = big->negative + topDigits + 9 * (chunkCount - 1);
+
+    // written from the end, into out itself if the whole text fits.
+    char* text = length < size ? out : malloc(length + 1);
+    char* position = text + length;
+    *position = '\0';
+
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        uint32_t chunk = chunks[i];
+        size_t digits = i + 1 < chunkCount ? 9 : topDigits;
+        for (size_t j = 0; j < digits; j++)
+        {
+            *--position = (char)('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    if (big->negative)
+    {
+        *--position = '-';
+    }
+    free(chunks);
+
+    if (text != out)
+    {
+        if (size > 0)
+        {
+            memcpy(out, text, size - 1);
+            out[size - 1] = '\0';
+        }
+        free(text);
+    }
+    return length;
+}
+
+void mtBigIntFromString(struct mtNumber* out, const char* digits, size_t size)
+{
+    bool negative = size > 0 && digits[0] == '-';
+    if (size > 0 && (digits[0] == '-' || digits[0] == '+'))
+    {
+        digits++;
+        size--;
+    }
+
+    // the reverse of mtBigIntStr, the digits go in 9 at a time, most significant first.
+    // 9 digits take less than 30 bits, so a limb per chunk is more than enough.
+    uint32_t* limbs = calloc(size / 9 + 1, sizeof(uint32_t));
+    size_t count = 0;
+
+    size_t chunkDigits = size % 9 ? size % 9 : 9;
+    for (size_t i = 0; i < size; i += chunkDigits, chunkDigits = 9)
+    {
+        uint32_t chunk = 0;
+        uint32_t factor = 1;
+        for (size_t j = 0; j < chunkDigits; j++)
+        {
+            chunk = chunk * 10 + (uint32_t)(digits[i + j] - '0');
+            factor *= 10;
+        }
+
+        uint32_t carry = multiplyAddSmall(limbs, count, factor, chunk);
+        if (carry)
+        {
+            limbs[count++] = carry;
+        }
+    }
+
+    setResult(out, limbs, count, negative);
+    free(limbs);
+}
+
+void mtBigIntKeep(struct mtBigInt* big)
+{
+    big->kept = true;
+}
+
+void mtBigIntMark(struct mtBigInt* big)
+{
+    big->marked = true;
+}
+
+size_t mtBigIntSweep()
+{
+    size_t live = 0;
+
+    struct mtBigInt** link = &bigInts;
+    while (*link)
+    {
+        struct mtBigInt* big = *link;
+        if (big->marked || big->kept)
+        {
+            big->marked = false;
+            live += sizeof(struct mtBigInt) + sizeof(uint32_t) * big->count;
+            link = &big->next;
+            continue;
+        }
+
+        *link = big->next;
+        free(big);
+    }
+
+    allocatedSinceSweep = 0;
+    return live;
+}
+
+size_t mtBigIntAllocatedSinceSweep()
+{
+    return allocatedSinceSweep;
+}
@@ -0,0 +1,183 @@
+
+#include <Mint.h>
+
+// a growable stack of pointers, used for both kinds of roots.
+struct mtGCRootStack {
+    void** items;
+    size_t count;
+    size_t capacity;
+};
+
+static struct mtGCRootStack scopeRoots;
+static struct mtGCRootStack tempRoots;
+
+// every tracked object, linked through mtObject.gcNext
+static struct mtObject* objects = NULL;
+
+static size_t allocatedSinceCollect = 0;
+
+// bytes of big ints allocated before the next collection, see mtBigInt.h
+static size_t bigIntThreshold = mtGCInitialBigIntThreshold;
+
+static struct mtGCStats stats = {
+    .threshold = mtGCInitialThreshold
+};
+
+static void pushRoot(struct mtGCRootStack* stack, void* item)
+{
+    if (stack->count >= stack->capacity)
+    {
+        stack->capacity = stack->capacity ? stack->capacity * 2 : 16;
+        stack->items = realloc(stack->items, sizeof(void*) * stack->capacity);
+    }
+    stack->items[stack->count++] = item;
+}
+
+static void markObject(void* value, void* userData)
+{
+    (void)userData;
+
+    struct mtObject* object = value;
+    if (object)
+    {
+        object->gcMarked = true;
+    }
+}
+
+static void markScope(struct mtScope* scope)
+{
+    // the parents are on the stack too, if they're still in use.
+    if (scope->variables)
+    {
+        mtHashMapForEach(scope->variables, &markObject, NULL);
+    }
+    for (size_t i = 0; i < scope->slotCount; i++)
+    {
+        markObject(scope->slots[i], NULL);
+    }
+}
+
+// what payloads point to isn't an object of its own, it's kept alive through them.
+static void markPayload(struct mtObject* object)
+{
+    if (object->type->mark)
+    {
+        object->type->mark(object->data);
+    }
+}
+
+static void sweep()
+{
+    struct mtObject** link = &objects;
+    while (*link)
+    {
+        struct mtObject* object = *link;
+        if (object->gcMarked)
+        {
+            object->gcMarked = false;
+            markPayload(object);
+            link = &object->gcNext;
+            continue;
+        }
+
+        *link = object->gcNext;
+        mtFreeObject(object);
+
+        stats.freed++;
+        stats.live--;
+    }
+}
+
+void mtGCCollect()
+{
+    for (size_t i = 0; i < scopeRoots.count; i++)
+    {
+        markScope(scopeRoots.items[i]);
+    }
+    for (size_t i = 0; i < tempRoots.count; i++)
+    {
+        markObject(tempRoots.items[i], NULL);
+    }
+
+    sweep();
+
+    // temporaries aren't collected, but the big ints they hold are still in use.
+    mtTempForEach(&markPayload);
+    size_t bigIntsLive = mtBigIntSweep();
+
+    stats.collections++;
+    allocatedSinceCollect = 0;
+
+    // let the heap grow with the live set, so big programs don't collect constantly.
+    stats.threshold = stats.live * 2;
+    if (stats.threshold < mtGCInitialThreshold)
+    {
+        stats.threshold = mtGCInitialThreshold;
+    }
+    bigIntThreshold = bigIntsLive * 2;
+    if (bigIntThreshold < mtGCInitialBigIntThreshold)
+    {
+        bigIntThreshold = mtGCInitialBigIntThreshold;
+    }
+}
+
+void mtGCMaybeCollect()
+{
+    if (allocatedSinceCollect >= stats.threshold || mtBigIntAllocatedSinceSweep() >= bigIntThreshold)
+    {
+        mtGCCollect();
+    }
+}
+
+void mtGCTrack(struct mtObject* object)
+{
+    object->gcMarked = false;
+    object->gcNext = objects;
+    objects = object;
+
+    allocatedSinceCollect++;
+    stats.allocated++;
+    stats.live++;
+    if (stats.live > stats.peakLive)
+    {
+        stats.peakLive = stats.live;
+    }
+}
+
+void mtGCPushScope(struct mtScope* scope)
+{
+    pushRoot(&scopeRoots, scope);
+}
+
+void mtGCPopScope()
+{
+    if (scopeRoots.count > 0)
+    {
+        scopeRoots.count--;
+    }
+}
+
+void mtGCPushTemp(struct mtObject* object)
+{
+    pushRoot(&tempRoots, object);
+}
+
+void mtGCPopTemps(size_t count)
+{
+    if (count > tempRoots.count)
+    {
+        count = tempRoots.count;
+    }
+    tempRoots.count -= count;
+}
+
+struct mtGCStats mtGCGetStats()
+{
+    return stats;
+}
+
+void mtGCPrintStats(FILE* stream)
+{
+    fprintf(stream, "gc: %zu collections, %zu allocated, %zu freed, %zu live, %zu peak live\n",
+            stats.collections, stats.allocated, stats.freed, stats.live, stats.peakLive);
+}
@@ -0,0 +1,63 @@
+
+#include "mtNumberObject.h"
+#include "mtBigInt.h"
+#include "mtUtilities.h"
+#include "mtTypeError.h"
+
+#include "internal/mtToken.h"
+
+double mtInterpretDecimal(struct Token* token)
+{
+	if (token == NULL)
+		return 0;
+
+	//the token is read where it is, it isn't null terminated.
+	double d;
+	int result = mtStringToDoubleN(&d, token->string, token->size);
+
+	if (result == mtSuccess)
+	{
+		return d;
+	}
+
+    size_t tokenSize = token->size;
+    char* tokenString = malloc(tokenSize * sizeof(char) + 1);
+    mtGetTokenString(*token, tokenString, tokenSize);
+
+	if (result == mtStringToFloatInconvertible)
+	{
+		typeError("Failed to read token: '%s' as decimal: Inconvertible", tokenString);
+	}
+
+	free(tokenString);
+	return 0;
+}
+void mtInterpretInteger(struct Token* token, struct mtNumber* out)
+{
+    out->type = INTEGER;
+    out->integer = 0;
+    if (token == NULL)
+        return;
+
+    size_t tokenSize = token->size;
+
+    int err = mtStringToIntN(&out->integer, token->string, tokenSize, 10);
+
+    if (err == mtSuccess)
+        return;
+
+    // the digits are all there, the int is just too big for an int64_t.
+    if (err == mtStringToIntOverflow || err == mtStringToIntUnderflow)
+    {
+        mtBigIntFromString(out, token->string, tokenSize);
+        return;
+    }
+    
+    char* tokenString = malloc(tokenSize * sizeof(char) + 1);
+    mtGetTokenString(*token, tokenString, tokenSize);
+
+    typeError("Failed to read token '%s' as number: inconvertible\n", tokenString);
+
+    free(tokenString);
+    out->integer = 0;
+}
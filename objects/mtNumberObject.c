@@ -9,82 +9,163 @@
 #include <math.h>
 #include <stdio.h>
 
+const struct Type mtNumberType = {
+    .size = sizeof(struct mtNumber),
+
+    .set = &numberSet,
+
+    .add = &numberAdd,
+    .sub = &numberSub,
+    .mul = &numberMul,
+    .div = &numberDiv,
+
+    .str = &numberStr,
+    .mark = &numberMark,
+
+    .isGreater = mtNumberIsGreater,
+    .isLesser = mtNumberIsLesser,
+    .isEqual = mtNumberIsEqual
+};
+
 void numberSet(void* a, void* b)
 {
-    memcpy(a, b, sizeof(struct mtNumber));
+    struct mtNumber* numA = a;
+    struct mtNumber* numB = b;
+
+    // only the member in use is copied, the rest of a is zeroed
+    // so equal numbers always have the same bytes.
+    struct mtNumber out;
+    memset(&out, 0, sizeof(struct mtNumber));
+
+    out.type = numB->type;
+    if (numB->type == DECIMAL)
+    {
+        out.decimal = numB->decimal;
+    } 
+    else if (numB->type == BIGINT)
+    {
+        // big ints never change, so they can be shared.
+        out.big = numB->big;
+    } else {
+        out.integer = numB->integer;
+    }
+    memcpy(numA, &out, sizeof(struct mtNumber));
 }
 
-void* numberAdd(void* a, void* b)
+static double toDouble(struct mtNumber* number)
+{
+    return number->type == DECIMAL ? number->decimal : mtBigIntToDouble(number);
+}
+
+void numberAdd(void* out, void* a, void* b)
 {
     struct mtNumber* numA = (struct mtNumber*)a;
     struct mtNumber* numB = (struct mtNumber*)b;
 
-	struct mtNumber* out = malloc(sizeof(struct mtNumber));
-    memset(out, 0, sizeof(struct mtNumber));
+	struct mtNumber* numOut = (struct mtNumber*)out;
+	int64_t result;
 
 	if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		out->type = DECIMAL;
-		double x = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double y = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-		out->decimal = x+y;
+		numOut->type = DECIMAL;
+		numOut->decimal = toDouble(numA) + toDouble(numB);
+	} 
+	else if (numA->type == INTEGER && numB->type == INTEGER &&
+			 !__builtin_add_overflow(numA->integer, numB->integer, &result))
+	{
+		numOut->type = INTEGER;
+		numOut->integer = result;
 	} else {
-		out->type = INTEGER;
-		out->integer = numA->integer + numB->integer;
+		mtBigIntAdd(numOut, numA, numB);
 	}
-	return (void*)out;
 }	
 
-void* numberSub(void* a, void* b)
+void numberSub(void* out, void* a, void* b)
 {
     struct mtNumber* numA = (struct mtNumber*)a;
     struct mtNumber* numB = (struct mtNumber*)b;
 
-	struct mtNumber* out = malloc(sizeof(struct mtNumber));
+	struct mtNumber* numOut = (struct mtNumber*)out;
+	int64_t result;
     
 	if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		out->type = DECIMAL;
-		double x = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double y = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-		out->decimal = x-y;
+		numOut->type = DECIMAL;
+		numOut->decimal = toDouble(numA) - toDouble(numB);
+	} 
+	else if (numA->type == INTEGER && numB->type == INTEGER &&
+			 !__builtin_sub_overflow(numA->integer, numB->integer, &result))
+	{
+		numOut->type = INTEGER;
+		numOut->integer = result;
 	} else {
-		out->type = INTEGER;
-		out->integer = numA->integer - numB->integer;
+		mtBigIntSub(numOut, numA, numB);
 	}
-	return (void*)out;
 }
 
 
-void* numberMul(void* a, void* b)
+void numberMul(void* out, void* a, void* b)
 {
 	struct mtNumber* numA = (struct mtNumber*)a;
     struct mtNumber* numB = (struct mtNumber*)b;
 
-	struct mtNumber* out = malloc(sizeof(struct mtNumber));
+	struct mtNumber* numOut = (struct mtNumber*)out;
+	int64_t result;
     
 	if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		out->type = DECIMAL;
-		double x = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double y = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-		out->decimal = x*y;
+		numOut->type = DECIMAL;
+		numOut->decimal = toDouble(numA) * toDouble(numB);
+	} 
+	else if (numA->type == INTEGER && numB->type == INTEGER &&
+			 !__builtin_mul_overflow(numA->integer, numB->integer, &result))
+	{
+		numOut->type = INTEGER;
+		numOut->integer = result;
 	} else {
-		out->type = INTEGER;
-		out->integer = numA->integer * numB->integer;
+		mtBigIntMul(numOut, numA, numB);
 	}
-	return out;
 }
 
-void* numberDiv(void* a, void* b)
+void numberDiv(void* out, void* a, void* b)
 {
     struct mtNumber* numA = (struct mtNumber*)a;
     struct mtNumber* numB = (struct mtNumber*)b;
 
-	struct mtNumber* out = malloc(sizeof(struct mtNumber));
+	struct mtNumber* numOut = (struct mtNumber*)out;
+
+	// ints are divided exactly, a double can't hold every int64_t.
+	if (numA->type != DECIMAL && numB->type != DECIMAL)
+	{
+		if (numB->type == INTEGER && numB->integer == 0)
+		{
+			typeError("Tried to divide by zero!");
+			numOut->type = INTEGER;
+			numOut->integer = 0;
+			return;
+		}
+
+		// INT64_MIN / -1 is the only quotient of two int64_ts that doesn't fit in one.
+		if (numA->type == INTEGER && numB->type == INTEGER && 
+			!(numA->integer == INT64_MIN && numB->integer == -1))
+		{
+			if (numA->integer % numB->integer == 0)
+			{
+				numOut->type = INTEGER;
+				numOut->integer = numA->integer / numB->integer;
+			} else {
+				numOut->type = DECIMAL;
+				numOut->decimal = (double)numA->integer / (double)numB->integer;
+			}
+			return;
+		}
+
+		mtBigIntDiv(numOut, numA, numB);
+		return;
+	}
     
-	double x = (numA->type == DECIMAL) ? numA->decimal : numA->integer;
-    double y = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
+	double x = toDouble(numA);
+    double y = toDouble(numB);
 
 	double quotient;
 	if (y != 0.0)
@@ -96,43 +177,53 @@ void* numberDiv(void* a, void* b)
 	}
 
 	//ints are always truncated when converting, so 1.2 becomes 1.
-	//thanks chatgpt for the fabs() check.
-	if (fabs(quotient - (int)quotient) == 0 && 
-		quotient <= INT_MAX && quotient >= INT_MIN)
+	//the range is checked first, converting a double that doesn't fit is undefined.
+	if (quotient >= -9223372036854775808.0 && quotient < 9223372036854775808.0 &&
+		quotient == (double)(int64_t)quotient)
 	{
-		out->type = INTEGER;
-		out->integer = (int)quotient;
-		return out;
+		numOut->type = INTEGER;
+		numOut->integer = (int64_t)quotient;
+		return;
 	}
 
-	out->type = DECIMAL;
-	out->decimal = quotient;
-	return out;
+	numOut->type = DECIMAL;
+	numOut->decimal = quotient;
 }
 
-char* numberStr(void* a)
+size_t numberStr(void* a, char* buffer, size_t size)
 {   
     struct mtNumber* numA = a;
 
     if (numA->type == INTEGER)
     {
-        char* str = malloc(sizeof(char)*12); 
-
-        snprintf(str, 12, "%d", numA->integer);
-
-        return str;
+        return mtIntToStringN(buffer, size, numA->integer);
     }
 
     if (numA->type == DECIMAL)
     {
-        char* str = malloc(sizeof(char)*64);
+        return mtDoubleToStringN(buffer, size, numA->decimal);
+    }
 
-        snprintf(str, 64, "%f", numA->decimal);
-      
-        return str;
+    if (numA->type == BIGINT)
+    {
+        return mtBigIntStr(numA->big, buffer, size);
     }
 
-    return NULL;
+    return 0;
+}
+
+void numberMark(void* a)
+{
+    struct mtNumber* numA = a;
+    if (numA->type == BIGINT)
+    {
+        mtBigIntMark(numA->big);
+    }
+}
+
+bool mtNumberIsInteger(const struct mtNumber* number)
+{
+    return number->type != DECIMAL;
 }
 
 bool mtNumberIsEqual (void* a, void* b)
@@ -142,15 +233,13 @@ bool mtNumberIsEqual (void* a, void* b)
 
 	if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		double a = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double b = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-
-        return a == b;
-	} else {
+        return toDouble(numA) == toDouble(numB);
+	} 
+	if (numA->type == INTEGER && numB->type == INTEGER)
+	{
         return numA->integer == numB->integer; 	
     }
-
-	return false;
+	return mtBigIntCompare(numA, numB) == 0;
 }
 
 bool mtNumberIsGreater (void* a, void* b)
@@ -160,13 +249,13 @@ bool mtNumberIsGreater (void* a, void* b)
     
     if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		double a = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double b = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-
-        return a > b;
-	} else {
+        return toDouble(numA) > toDouble(numB);
+	} 
+	if (numA->type == INTEGER && numB->type == INTEGER)
+	{
         return numA->integer > numB->integer; 	
     }
+	return mtBigIntCompare(numA, numB) > 0;
 }
 
 bool mtNumberIsLesser (void* a, void* b)
@@ -176,84 +265,11 @@ bool mtNumberIsLesser (void* a, void* b)
 
     if (numA->type == DECIMAL || numB->type == DECIMAL)
 	{
-		double a = (numA->type == DECIMAL) ? numA->decimal : numA->integer; 
-		double b = (numB->type == DECIMAL) ? numB->decimal : numB->integer;
-
-        return a > b;
-	} else {
-        return numA->integer > numB->integer; 	
-    }
-}
-
-float mtInterpretDecimal(struct Token* token)
-{
-	if (token == NULL)
-		return 0;
-	float f;
-
-	size_t tokenSize = token->size;
-
-	//node->token.string isn't null terminated.
-	char* str = malloc(tokenSize * sizeof(char) +1);
-	memcpy(str, token->string, tokenSize);
-	str[tokenSize] = '\0';
-
-	int result = mtStringToFloat(&f, str);	
-	free(str);
-
-	if (result == mtSuccess)
+        return toDouble(numA) < toDouble(numB);
+	} 
+	if (numA->type == INTEGER && numB->type == INTEGER)
 	{
-		return f;
-	}
-
-    char* tokenString = malloc(tokenSize * sizeof(char) + 1);
-    mtGetTokenString(*token, tokenString, tokenSize);
-
-	if (result == mtStringToFloatInconvertible)
-	{
-		typeError("Failed to read token: '%s' as decimal: Inconvertible", tokenString);
-	}
-
-	free(tokenString);
-	return 0;
-}
-int mtInterpretInteger(struct Token* token)
-{
-    if (token == NULL)
-        return 0;
-
-    size_t tokenSize = token->size;
-
-    int num = 0; 
-    
-    //would use a variable-sized array, but that's not supported everywhere.
-    char* str = malloc(tokenSize * sizeof(char) + 1 );
-
-    memcpy(str, token->string, tokenSize);
-    str[tokenSize] = '\0';
-
-    int err = mtStringToInt(&num, str, 10);
-
-    free(str);
-
-    if (err == mtSuccess)
-        return num;
-    
-    char* tokenString = malloc(tokenSize * sizeof(char) + 1);
-    mtGetTokenString(*token, tokenString, tokenSize);
-
-    if (err == mtStringToIntInconvertible)
-    {
-        typeError("Failed to read token '%s' as number: inconvertible\n", tokenString);
+        return numA->integer < numB->integer; 	
     }
-    if (err == mtStringToIntOverflow)
-    {
-        typeError("Failed to read token '%s' as number: integer overflow\n", tokenString);
-    }
-    if (err == mtStringToIntUnderflow)
-    {
-        typeError("Failed to read token '%s' as number: integer undeflow\n", tokenString);
-    }
-    free(tokenString);
-    return 0;
+	return mtBigIntCompare(numA, numB) < 0;
 }
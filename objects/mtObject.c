@@ -1,15 +1,93 @@
 
 #include <Mint.h>
+#include <stddef.h> // for max_align_t
 
 
-struct mtObject* mtCreateObject(struct Type type)
+struct mtObject* mtCreateObject(const struct Type* type)
 {
-    struct mtObject* var = malloc(sizeof(struct mtObject));
-    var->data = malloc(type.size);
+    mtGCMaybeCollect();
+
+    struct mtObject* var = mtPoolAlloc(sizeof(struct mtObject));
+    var->data = mtPoolAlloc(type->size);
     var->type = type;
 
-    memset(var->data, 0, var->type.size);
+    memset(var->data, 0, var->type->size);
+    var->temporary = false;
+    var->isConstant = false;
+
+    mtGCTrack(var);
 
     return var;
 }
 
+void mtFreeObject(struct mtObject* object)
+{
+    if (!object)
+        return;
+
+    mtPoolFree(object->data, object->type->size);
+    mtPoolFree(object, sizeof(struct mtObject));
+}
+
+// temporaries live here until the statement that made them is done.
+static struct mtArena tempArena;
+
+struct mtObject* mtCreateTempObject(const struct Type* type)
+{
+    struct mtObject* var = mtArenaAlloc(&tempArena, sizeof(struct mtObject) + type->size);
+    var->data = var + 1;
+    var->type = type;
+    var->gcNext = NULL;
+    var->gcMarked = false;
+    var->temporary = true;
+    var->isConstant = false;
+
+    memset(var->data, 0, var->type->size);
+
+    return var;
+}
+
+struct mtArenaMark mtTempMark()
+{
+    return mtArenaGetMark(&tempArena);
+}
+
+void mtTempRelease(struct mtArenaMark mark)
+{
+    mtArenaReset(&tempArena, mark);
+}
+
+struct mtObject* mtTempReleaseKeeping(struct mtArenaMark mark, struct mtObject* keep)
+{
+    if (!keep)
+    {
+        mtTempRelease(mark);
+        return NULL;
+    }
+
+    // keep could be inside the memory that's about to be released, so copy it out first.
+    const struct Type* type = keep->type;
+    max_align_t saved[type->size / sizeof(max_align_t) + 1];
+    type->set(saved, keep->data);
+
+    mtTempRelease(mark);
+
+    struct mtObject* out = mtCreateTempObject(type);
+    type->set(out->data, saved);
+
+    return out;
+}
+
+static size_t visitTemp(void* allocation, void* userData)
+{
+    struct mtObject* object = allocation;
+    void (*callback)(struct mtObject*) = userData;
+
+    callback(object);
+    return sizeof(struct mtObject) + object->type->size;
+}
+
+void mtTempForEach(void (*callback)(struct mtObject* object))
+{
+    mtArenaForEach(&tempArena, &visitTemp, (void*)callback);
+}
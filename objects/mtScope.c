@@ -1,35 +1,114 @@
 #include "mtScope.h"
 
+#include <string.h>
+
+
+static size_t functionEpoch = 0;
+
+size_t mtScopeGetFunctionEpoch()
+{
+    return functionEpoch;
+}
+
+void mtInitScope(struct mtScope* scope, struct mtScope* parent)
+{
+    scope->parent = parent;
+    scope->variables = NULL;
+    scope->functions = NULL;
+
+    scope->slots = NULL;
+    scope->slotNames = NULL;
+    scope->slotCount = 0;
+}
+
+void mtReleaseScope(struct mtScope* scope, void (*freeFunction)(void*))
+{
+    if (scope->variables)
+    {
+        mtHashMapDestroy(scope->variables, NULL);
+        scope->variables = NULL;
+    }
+    if (scope->functions)
+    {
+        mtHashMapDestroy(scope->functions, freeFunction);
+        scope->functions = NULL;
+        functionEpoch++;
+    }
+}
 
 struct mtScope* mtCreateScope()
 {
     struct mtScope* scope = malloc(sizeof(struct mtScope));
-
-    scope->parent = NULL;
-    scope->variables = mtHashMapCreate(mtScopeDefaultSize);
-    scope->functions = mtHashMapCreate(mtScopeDefaultSize);
+    mtInitScope(scope, NULL);
 
     return scope;
 }
 
-struct mtObject* getObjectFromScope(struct mtScope* scope, const char* key)
+void mtDestroyScope(struct mtScope* scope, void (*freeFunction)(void*))
 {
     if (!scope)
     {
-        return NULL;
+        return;
     }
 
-    struct mtObject* out = NULL;
+    mtReleaseScope(scope, freeFunction);
+    free(scope);
+}
 
-    if ( (out = mtHashMapGet(scope->variables, key)) )
+void mtScopeSetObjectN(struct mtScope* scope, const char* key, size_t size, uint32_t hash, struct mtObject* object)
+{
+    if (!scope->variables)
     {
-        return out;
+        scope->variables = mtHashMapCreate(mtScopeDefaultSize);
     }
+    mtHashMapPutN(scope->variables, key, size, hash, object);
+}
+
+void mtScopeSetObject(struct mtScope* scope, const char* key, struct mtObject* object)
+{
+    size_t size = strlen(key);
+    mtScopeSetObjectN(scope, key, size, mtHashMapHash(key, size), object);
+}
+
+struct mtFunction* mtScopeSetFunction(struct mtScope* scope, const char* key, struct mtFunction* function)
+{
+    if (!scope->functions)
+    {
+        scope->functions = mtHashMapCreate(mtScopeDefaultSize);
+    }
+
+    struct mtFunction* old = mtHashMapGet(scope->functions, key);
+    mtHashMapPut(scope->functions, key, function);
+    functionEpoch++;
+
+    return old;
+}
+
+static struct mtObject* getSlotByName(struct mtScope* scope, const char* key, size_t size)
+{
+    for (size_t i = 0; i < scope->slotCount; i++)
+    {
+        const char* name = scope->slotNames[i];
+        if (strncmp(name, key, size) == 0 && name[size] == '\0')
+        {
+            return scope->slots[i];
+        }
+    }
+    return NULL;
+}
+
+struct mtObject* getObjectFromScopeN(struct mtScope* scope, const char* key, size_t size, uint32_t hash)
+{
+    struct mtObject* out = NULL;
     
     struct mtScope* currentScope = scope;
     while(currentScope)
     {
-        if ( (out = mtHashMapGet(currentScope->variables, key)) )
+        if ( currentScope->variables && (out = mtHashMapGetN(currentScope->variables, key, size, hash)) )
+        {
+            return out;
+        }
+        if ( (out = getSlotByName(currentScope, key, size)) )
         {
             return out;
         }
@@ -41,7 +120,13 @@ struct mtObject* getObjectFromScope(struct mtScope* scope, const char* key)
     return NULL;
 }
 
-struct mtFunction* getFunctionFromScope(struct mtScope* scope, const char* key)
+struct mtObject* getObjectFromScope(struct mtScope* scope, const char* key)
+{
+    size_t size = strlen(key);
+    return getObjectFromScopeN(scope, key, size, mtHashMapHash(key, size));
+}
+
+struct mtFunction* getFunctionFromScopeN(struct mtScope* scope, const char* key, size_t size, uint32_t hash)
 {
     if (scope == NULL)
     {
@@ -53,14 +138,20 @@ struct mtFunction* getFunctionFromScope(struct mtScope* scope, const char* key)
     struct mtScope* currentScope = scope;
     while (currentScope)
     {
-        if ( (out = mtHashMapGet(scope->functions, key)) )
+        if ( currentScope->functions && (out = mtHashMapGetN(currentScope->functions, key, size, hash)) )
         {
             return out;
         }
 
         //check the scope above
-        currentScope = scope->parent;
+        currentScope = currentScope->parent;
     }
 
     return NULL;
 }
+
+struct mtFunction* getFunctionFromScope(struct mtScope* scope, const char* key)
+{
+    size_t size = strlen(key);
+    return getFunctionFromScopeN(scope, key, size, mtHashMapHash(key, size));
+}
@@ -4,16 +4,21 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "mtOutput.h"
+
 static void typeError(const char* fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
 
+    // the output printed before the error goes first.
+    mtOutputFlush();
+
     vfprintf(stderr, fmt, args);
     fprintf(stderr, "\n");
 
     if (fmt[strlen(fmt)] != '\n')
     {
-        printf("\n");
+        mtOutputWrite("\n", 1);
     }
 }
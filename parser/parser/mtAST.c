@@ -40,6 +40,20 @@ struct ASTNode* mtASTCreateNode()
 
     out->children = malloc (sizeof(struct ASTNode*) * mtASTInitialChildCapacity);
     mtCreateToken(&out->token);
+    out->hash = 0;
+    out->parameterIndex = -1;
+    out->cachedFunction = NULL;
+    out->cachedEpoch = 0;
+    out->isTailCall = false;
+    out->inferred = Inferred_None;
+    out->operands = Operands_Unknown;
+    out->prototype = NULL;
+    out->inlined = NULL;
+    memset(&out->constant, 0, sizeof(struct mtNumber));
+    out->literal.type = NULL;
+    out->sameAs = NULL;
+    out->lastResult = NULL;
+    out->keepsResult = false;
 
     return out;
 }
@@ -48,11 +62,26 @@ struct ASTNode* mtASTTokenCreateNode(struct Token token)
 
     struct ASTNode* out = malloc( sizeof(struct ASTNode) );
     
+    out->type = NodeType_None;
     out->childCount = 0;
     out->childCapacity = mtASTInitialChildCapacity;
     
     out->children = malloc (sizeof(struct ASTNode*) * mtASTInitialChildCapacity);
     out->token = token;
+    out->hash = mtHashMapHash(token.string, token.size);
+    out->parameterIndex = -1;
+    out->cachedFunction = NULL;
+    out->cachedEpoch = 0;
+    out->isTailCall = false;
+    out->inferred = Inferred_None;
+    out->operands = Operands_Unknown;
+    out->prototype = NULL;
+    out->inlined = NULL;
+    memset(&out->constant, 0, sizeof(struct mtNumber));
+    out->literal.type = NULL;
+    out->sameAs = NULL;
+    out->lastResult = NULL;
+    out->keepsResult = false;
 
     return out;
 }
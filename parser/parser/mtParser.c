@@ -4,6 +4,8 @@
 #include "internal/mtToken.h"
 #include <stdlib.h>
 
+#include "mtOutput.h"
+
 // ___________ Helper functions ______________
 
 //@brief prints errors to stderr, uses printf formats
@@ -14,6 +16,9 @@ void parserError(struct mtParserState state, const char* fmt, ...)
    
     struct Token token = mtParserGetToken(&state);
 
+    // the output printed before the error goes first.
+    mtOutputFlush();
+
     char tokenstr[token.size];
     mtGetTokenString(token, (char*)&tokenstr, token.size);
 
@@ -21,7 +26,7 @@ void parserError(struct mtParserState state, const char* fmt, ...)
     vfprintf(stderr, fmt, args);
 
     if (fmt[strlen(fmt)-1] != '\n')
-        printf("\n");
+        mtOutputWrite("\n", 1);
 }
 void unexpectedTokenError(struct mtParserState state)
 {
@@ -29,7 +34,7 @@ void unexpectedTokenError(struct mtParserState state)
 }
 
 /*
-*   block       = statments | expressions | function_def | if
+*   block       = statments | expressions | function_def | if | while | for
 *   statement   = identifier {assign} expression 
 *   expression  = {add | sub} term {add | sub} term 
 *   term        = factor  {mul | div} factor  
@@ -39,8 +44,11 @@ void unexpectedTokenError(struct mtParserState state)
 *   function_call   = identifier "lparen" [arguments] "rparen"
 *   
 *   if  = "if" {conditional} block "end"
+*   while   = "while" {conditional} block "end"
+*   for     = "for" identifier "assign" expression "comma" expression block "end"
 *
-*   params      = ("comma", identifier) // () = list, comma separates the identifiers
+*   params      = ("comma", identifier ["colon" identifier]) // () = list, comma separates the identifiers
+*                                                         // the optional identifier is a type hint
 *   arguments   = ("comma", expression) // "comma" separates the expressions 
 *   conditional = true | false | expression {comparison} expression 
 *   comparison  = {greaterThan} | {lesserThan} | {greaterThanOrEqual} | {lesserThanOrEqual} | {isEqual} | {isNotEqual}
@@ -231,6 +239,23 @@ struct ASTNode* parseParams(struct mtParserState* state)
         }
     
         mtParserAdvance(state);
+
+        // the type hint becomes the parameter's only child.
+        if (mtParserCheck(state, TokenType_Colon) && parameters->childCount > 0)
+        {
+            mtParserAdvance(state);
+            if (!mtParserCheck(state, TokenType_Identifier))
+            {
+                parserError(*state, "Expected a type after the colon!");
+                mtASTFree(parameters);
+                return NULL;
+            }
+
+            struct ASTNode* parameter = parameters->children[parameters->childCount - 1];
+            mtASTAddChildNode(parameter, mtASTTokenCreateNode(mtParserGetToken(state)));
+            mtParserAdvance(state);
+        }
+
         if (!mtParserCheck(state, TokenType_Comma) && !mtParserCheck(state, TokenType_RightParentheses))
         {
             parserError(*state, "Commas must separate all parameters!");
@@ -287,6 +312,11 @@ struct ASTNode* parseFunctionDef(struct mtParserState* state)
     mtASTAddChildNode(functionDef, identifierNode);
 
     struct ASTNode* parameterList = parseParams(state);
+    if (!parameterList)
+    {
+        mtASTFree(functionDef);
+        return NULL;
+    }
     parameterList->type = NodeType_ParameterList;
     mtASTAddChildNode(functionDef, parameterList);
 
@@ -458,7 +488,118 @@ struct ASTNode* parseIfStatement(struct mtParserState* state)
     mtASTAddChildNode(ifNode, condition);
     mtASTAddChildNode(ifNode, block);
 
-    return ifNode;
+    if (mtParserCheck(state, TokenType_EndKeyword))
+    {
+        mtParserAdvance(state);
+        return ifNode;
+    }
+
+    parserError(*state, "If statements must end with \'end\' keyword!");
+    mtASTFree(ifNode);
+    return NULL;
+}
+
+struct ASTNode* parseWhileLoop(struct mtParserState* state)
+{
+    while (mtParserCheck(state, TokenType_EndOfStatement))
+    {
+        mtParserAdvance(state);
+    }
+    if (!mtParserCheck(state, TokenType_WhileKeyword))
+    {
+        return NULL;
+    }
+    mtParserAdvance(state); //advance past the while
+
+    struct ASTNode* condition = parseCondition(state);
+    if (condition == NULL)
+    {
+        parserError(*state, "Expected a condition after \'while\'!");
+        return NULL;
+    }
+
+    struct ASTNode* whileNode = mtASTCreateNode();
+    whileNode->type = NodeType_WhileLoop;
+
+    mtASTAddChildNode(whileNode, condition);
+    mtASTAddChildNode(whileNode, parseBlock(state));
+
+    if (mtParserCheck(state, TokenType_EndKeyword))
+    {
+        mtParserAdvance(state);
+        return whileNode;
+    }
+
+    parserError(*state, "While loops must end with \'end\' keyword!");
+    mtASTFree(whileNode);
+    return NULL;
+}
+
+struct ASTNode* parseForLoop(struct mtParserState* state)
+{
+    while (mtParserCheck(state, TokenType_EndOfStatement))
+    {
+        mtParserAdvance(state);
+    }
+    if (!mtParserCheck(state, TokenType_ForKeyword))
+    {
+        return NULL;
+    }
+    mtParserAdvance(state); //advance past the for
+
+    if (!mtParserCheck(state, TokenType_Identifier))
+    {
+        parserError(*state, "For loops need a counter, like \'for i = 1, 10\'!");
+        return NULL;
+    }
+    struct Token identifier = mtParserGetToken(state);
+    mtParserAdvance(state);
+
+    if (!mtParserCheck(state, TokenType_OperatorAssign))
+    {
+        parserError(*state, "Expected \'=\' after the counter of a for loop!");
+        return NULL;
+    }
+    mtParserAdvance(state);
+
+    struct ASTNode* first = parseExpression(state);
+    if (first == NULL || !mtParserCheck(state, TokenType_Comma))
+    {
+        parserError(*state, "Expected the first and last value of the counter, separated by a comma!");
+        mtASTFree(first);
+        return NULL;
+    }
+    mtParserAdvance(state);
+
+    struct ASTNode* last = parseExpression(state);
+    if (last == NULL)
+    {
+        parserError(*state, "Expected the last value of the counter after the comma!");
+        mtASTFree(first);
+        return NULL;
+    }
+
+    // children: counter, first, last, block
+    struct ASTNode* forNode = mtASTCreateNode();
+    forNode->type = NodeType_ForLoop;
+
+    struct ASTNode* counter = mtASTTokenCreateNode(identifier);
+    counter->type = NodeType_Identifier;
+
+    mtASTAddChildNode(forNode, counter);
+    mtASTAddChildNode(forNode, first);
+    mtASTAddChildNode(forNode, last);
+    mtASTAddChildNode(forNode, parseBlock(state));
+
+    if (mtParserCheck(state, TokenType_EndKeyword))
+    {
+        mtParserAdvance(state);
+        return forNode;
+    }
+
+    parserError(*state, "For loops must end with \'end\' keyword!");
+    mtASTFree(forNode);
+    return NULL;
 }
 
 struct ASTNode* parseFunctionCall(struct mtParserState* state)
@@ -517,6 +658,16 @@ struct ASTNode* parseBlock(struct mtParserState* state)
             mtASTAddChildNode(block, child);
             continue;
         }
+        if ( (child = parseWhileLoop(state)) )
+        {
+            mtASTAddChildNode(block, child);
+            continue;
+        }
+        if ( (child = parseForLoop(state)) )
+        {
+            mtASTAddChildNode(block, child);
+            continue;
+        }
 
         if ( (child = parseStatement(state)) )
         {
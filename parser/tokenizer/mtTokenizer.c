@@ -18,6 +18,7 @@ struct Token* mtTokenize(char* str, struct TokenTypeRules rules, size_t* tokenCo
         rules.leftParentheses,
         rules.rightParentheses,
         rules.commaChar,
+        rules.colonChar,
 
         rules.endStatementChar,
         rules.separatorChar,
@@ -77,6 +78,12 @@ void mtTokenizerSetTokenType(struct Token* token, struct TokenTypeRules rules)
             return;
         }
 
+        if (character == rules.colonChar)
+        {
+            token->type = TokenType_Colon;
+            return;
+        }
+
         if (character == rules.leftParentheses)
         {
             token->type = TokenType_LeftParentheses;
@@ -132,6 +139,16 @@ void mtTokenizerSetTokenType(struct Token* token, struct TokenTypeRules rules)
         token->type = TokenType_IfKeyword;
         return;
     }
+    if (mtTokenCmp(*token, mtCreateStringToken(rules.whileKeyword)) == 0)
+    {
+        token->type = TokenType_WhileKeyword;
+        return;
+    }
+    if (mtTokenCmp(*token, mtCreateStringToken(rules.forKeyword)) == 0)
+    {
+        token->type = TokenType_ForKeyword;
+        return;
+    }
 
 
     bool isIntegerLiteral = mtOnlyOfN(token->string, token->size, (char*)&rules.numbers[0], 10);
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Runs a program and checks that it prints what's in the expected file, errors included.
+# The version line is left out.
+#
+# usage: expect.sh path/to/mint program.mt expected.out [options...]
+
+mint=$1
+program=$2
+expected=$3
+shift 3
+
+directory=$(mktemp -d) || exit 1
+trap 'rm -rf "$directory"' EXIT
+
+"$mint" "$@" "$program" 2>&1 | sed '1{/^Mint version /d;}' > "$directory/output"
+
+if ! diff -u "$expected" "$directory/output"; then
+    echo "$program doesn't print what's in $expected"
+    exit 1
+fi
@@ -0,0 +1,26 @@
+#!/bin/sh
+# Runs a program with and without --jit, both have to print the same, errors included,
+# and what they print has to be what's in the expected file. The version line is left out.
+#
+# usage: compare.sh path/to/mint program.mt expected.out [options for both runs...]
+
+mint=$1
+program=$2
+expected=$3
+shift 3
+
+directory=$(mktemp -d) || exit 1
+trap 'rm -rf "$directory"' EXIT
+
+"$mint" "$@" "$program" 2>&1 | sed '1{/^Mint version /d;}' > "$directory/interpreted"
+"$mint" --jit "$@" "$program" 2>&1 | sed '1{/^Mint version /d;}' > "$directory/compiled"
+
+if ! diff -u "$expected" "$directory/interpreted"; then
+    echo "$program doesn't print what's in $expected"
+    exit 1
+fi
+
+if ! diff -u "$directory/interpreted" "$directory/compiled"; then
+    echo "$program prints something else with --jit $*"
+    exit 1
+fi
@@ -0,0 +1,115 @@
+#include "mtArena.h"
+
+static size_t alignUp(size_t size)
+{
+    return (size + mtArenaAlignment - 1) & ~(size_t)(mtArenaAlignment - 1);
+}
+
+static struct mtArenaBlock* createBlock(size_t size)
+{
+    struct mtArenaBlock* block = malloc(sizeof(struct mtArenaBlock) + size);
+    if (!block)
+        return NULL;
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
+
+void mtArenaCreate(struct mtArena* arena)
+{
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+void mtArenaDestroy(struct mtArena* arena)
+{
+    struct mtArenaBlock* block = arena->first;
+    while (block)
+    {
+        struct mtArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+void* mtArenaAlloc(struct mtArena* arena, size_t size)
+{
+    size = alignUp(size);
+
+    struct mtArenaBlock* block = arena->current;
+    if (block && block->used + size <= block->size)
+    {
+        void* out = block->data + block->used;
+        block->used += size;
+        return out;
+    }
+
+    // try the blocks that were left over from an earlier reset.
+    struct mtArenaBlock* next = block ? block->next : arena->first;
+    if (!next || next->size < size)
+    {
+        struct mtArenaBlock* newBlock = createBlock(size > mtArenaBlockSize ? size : mtArenaBlockSize);
+        if (!newBlock)
+            return NULL;
+
+        newBlock->next = next;
+        if (block)
+            block->next = newBlock;
+        else
+            arena->first = newBlock;
+
+        next = newBlock;
+    }
+
+    next->used = size;
+    arena->current = next;
+
+    return next->data;
+}
+
+struct mtArenaMark mtArenaGetMark(struct mtArena* arena)
+{
+    struct mtArenaMark mark;
+    mark.block = arena->current;
+    mark.used = arena->current ? arena->current->used : 0;
+
+    return mark;
+}
+
+void mtArenaReset(struct mtArena* arena, struct mtArenaMark mark)
+{
+    arena->current = mark.block;
+    if (mark.block)
+    {
+        mark.block->used = mark.used;
+    }
+}
+
+void mtArenaForEach(struct mtArena* arena, size_t (*visit)(void* allocation, void* userData), void* userData)
+{
+    if (!arena->current)
+    {
+        return;
+    }
+
+    // the blocks are linked in the order they were used, the ones after current are left over.
+    for (struct mtArenaBlock* block = arena->first; block; block = block->next)
+    {
+        size_t position = 0;
+        while (position < block->used)
+        {
+            position += alignUp(visit(block->data + position, userData));
+        }
+
+        if (block == arena->current)
+        {
+            break;
+        }
+    }
+}
@@ -3,25 +3,91 @@
 
 //djb2 algorithm by Dan Bernstein
 //http://www.cse.yorku.ca/~oz/hash.html
-unsigned long hash(unsigned char *str)
+//
+// the table only looks at the low bits, so the result is mixed with a Fibonacci multiplication.
+uint32_t mtHashMapHash(const char* key, size_t size)
 {
-    unsigned long hash = 5381;
-    int c;
+    uint64_t hash = 5381;
 
-    while (c = *str++)
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+    for (size_t i = 0; i < size; i++)
+        hash = ((hash << 5) + hash) + (unsigned char)key[i]; /* hash * 33 + c */
 
-    return hash;
+    return (uint32_t)((hash * 0x9E3779B97F4A7C15ull) >> 32);
 }
 
-struct mtHashMapEntry* create_hashmap_entry(const char* key, void* value)
+static const char* getKey(const struct mtHashMapEntry* entry)
 {
-    struct mtHashMapEntry* entry = malloc(sizeof(struct mtHashMapEntry)); 
+    return entry->size < mtHashMapInlineKeySize ? entry->key.inlined : entry->key.allocated;
+}
 
-    entry->key = strdup(key);
-    entry->value = value; 
+static void freeKey(struct mtHashMapEntry* entry)
+{
+    if (entry->size >= mtHashMapInlineKeySize)
+    {
+        free(entry->key.allocated);
+    }
+}
 
-    return entry;
+//@returns the entry with key, or NULL.
+static struct mtHashMapEntry* find(struct mtHashMap* map, const char* key, size_t size, uint32_t hash)
+{
+    size_t mask = map->size - 1;
+    size_t index = hash & mask;
+
+    // an entry closer to its slot than the key would be means the key isn't there, see insert.
+    for (uint32_t distance = 1; ; distance++)
+    {
+        struct mtHashMapEntry* entry = &map->entries[index];
+        if (entry->distance < distance)
+        {
+            return NULL;
+        }
+        if (entry->hash == hash && entry->size == size && memcmp(getKey(entry), key, size) == 0)
+        {
+            return entry;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+//@brief Puts entry in, its key can't be in the map already and there has to be an empty slot.
+static void insert(struct mtHashMap* map, struct mtHashMapEntry entry)
+{
+    size_t mask = map->size - 1;
+    size_t index = entry.hash & mask;
+    entry.distance = 1;
+
+    while (map->entries[index].distance != 0)
+    {
+        // whichever is closer to its slot moves on.
+        if (map->entries[index].distance < entry.distance)
+        {
+            struct mtHashMapEntry displaced = map->entries[index];
+            map->entries[index] = entry;
+            entry = displaced;
+        }
+        index = (index + 1) & mask;
+        entry.distance++;
+    }
+    map->entries[index] = entry;
+}
+
+static void grow(struct mtHashMap* map)
+{
+    struct mtHashMapEntry* old = map->entries;
+    size_t oldSize = map->size;
+
+    map->size *= 2;
+    map->entries = calloc(map->size, sizeof(struct mtHashMapEntry));
+
+    for (size_t i = 0; i < oldSize; i++)
+    {
+        if (old[i].distance != 0)
+        {
+            insert(map, old[i]);
+        }
+    }
+    free(old);
 }
 
 // PUBLIC FUNCTIONS
@@ -29,9 +95,13 @@ struct mtHashMapEntry* create_hashmap_entry(const char* key, void* value)
 struct mtHashMap* mtHashMapCreate(size_t initialSize)
 {
     struct mtHashMap* map = malloc(sizeof(struct mtHashMap));
-    
-    map->buckets = calloc(initialSize, sizeof(struct mtHashMapEntry*));
-    map->size = initialSize;
+
+    map->size = mtHashMapMinSize;
+    while (map->size < initialSize)
+    {
+        map->size *= 2;
+    }
+    map->entries = calloc(map->size, sizeof(struct mtHashMapEntry));
     map->count = 0;
 
     return map;
@@ -40,75 +110,95 @@ struct mtHashMap* mtHashMapCreate(size_t initialSize)
 void mtHashMapDestroy(struct mtHashMap* map, void (*free_value)(void*))
 {
     for (size_t i = 0; i < map->size; i++) {
-        struct mtHashMapEntry *entry = map->buckets[i];
-        while (entry) {
-            struct mtHashMapEntry *tmp = entry;
-            entry = entry->next;
-            free((void*)tmp->key);
-            if (free_value)
-                free_value(tmp->value);
-            free(tmp);
-        }
+        struct mtHashMapEntry* entry = &map->entries[i];
+        if (entry->distance == 0)
+            continue;
+
+        freeKey(entry);
+        if (free_value)
+            free_value(entry->value);
     }
-    free(map->buckets);
+    free(map->entries);
     free(map);
 }
 
-void mtHashMapPut(struct mtHashMap* map, const char* key, void* value)
+void mtHashMapPutN(struct mtHashMap* map, const char* key, size_t size, uint32_t keyHash, void* value)
 {
-    unsigned int index = hash((unsigned char*)key) % map->size;
-    
-    struct mtHashMapEntry* entry = map->buckets[index];
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            entry->value = value; // overwrite pointer
-            return;
-        }
-        entry = entry->next;
+    struct mtHashMapEntry* found = find(map, key, size, keyHash);
+    if (found) {
+        found->value = value; // overwrite pointer
+        return;
     }
 
-    // Prepend new entry
-    struct mtHashMapEntry *new_entry = create_hashmap_entry(key, value);
-    new_entry->next = map->buckets[index];
-    map->buckets[index] = new_entry;
+    if ((map->count + 1) * 8 > map->size * mtHashMapMaxLoad)
+        grow(map);
+
+    struct mtHashMapEntry entry;
+    entry.hash = keyHash;
+    entry.size = size;
+    entry.value = value;
+
+    if (size < mtHashMapInlineKeySize) {
+        memcpy(entry.key.inlined, key, size);
+        entry.key.inlined[size] = '\0';
+    } else {
+        entry.key.allocated = malloc(size + 1);
+        memcpy(entry.key.allocated, key, size);
+        entry.key.allocated[size] = '\0';
+    }
+
+    insert(map, entry);
     map->count++;
 }
 
+void mtHashMapPut(struct mtHashMap* map, const char* key, void* value)
+{
+    size_t size = strlen(key);
+    mtHashMapPutN(map, key, size, mtHashMapHash(key, size), value);
+}
+
 void mtHashMapRemove(struct mtHashMap* map, const char* key)
 {
-    unsigned int index = hash((unsigned char*)key) % map->size;
-
-    struct mtHashMapEntry* entry;
-    struct mtHashMapEntry* prev = NULL;
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (prev)
-                prev->next = entry->next;
-            else
-                map->buckets[index] = entry->next;
-
-            free((void*)entry->key);
-            free(entry);
-            map->count--;
-            return;
-        }
-        prev = entry;
-        entry = entry->next;
+    size_t size = strlen(key);
+
+    struct mtHashMapEntry* entry = find(map, key, size, mtHashMapHash(key, size));
+    if (!entry)
+        return;
+
+    freeKey(entry);
+    map->count--;
+
+    // the entries after it which aren't in their own slot move back one.
+    size_t mask = map->size - 1;
+    size_t index = entry - map->entries;
+    size_t next = (index + 1) & mask;
+
+    while (map->entries[next].distance > 1) {
+        map->entries[index] = map->entries[next];
+        map->entries[index].distance--;
+
+        index = next;
+        next = (next + 1) & mask;
     }
+    map->entries[index].distance = 0;
 }
 
-void* mtHashMapGet(struct mtHashMap* map, const char* key)
+void* mtHashMapGetN(struct mtHashMap* map, const char* key, size_t size, uint32_t keyHash)
 {
-    unsigned int index = hash((unsigned char*)key) % map->size;
+    struct mtHashMapEntry* entry = find(map, key, size, keyHash);
+    return entry ? entry->value : NULL;
+}
 
-    struct mtHashMapEntry*entry = map->buckets[index];
+void* mtHashMapGet(struct mtHashMap* map, const char* key)
+{
+    size_t size = strlen(key);
+    return mtHashMapGetN(map, key, size, mtHashMapHash(key, size));
+}
 
-    while (entry) {
-        if (strcmp(entry->key, key) == 0)
-            return entry->value;
-        entry = entry->next;
+void mtHashMapForEach(struct mtHashMap* map, void (*callback)(void* value, void* userData), void* userData)
+{
+    for (size_t i = 0; i < map->size; i++) {
+        if (map->entries[i].distance != 0)
+            callback(map->entries[i].value, userData);
     }
-    return NULL;
 }
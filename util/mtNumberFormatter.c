@@ -0,0 +1,511 @@
+#include "mtUtilities.h"
+
+#include <float.h>
+#include <math.h>
+
+/*
+*   Numbers to text, see mtIntToStringN and mtDoubleToStringN.
+*
+*   Ints are written two digits at a time from a table. Doubles are written
+*   with the fewest digits that still read back as the same double, found
+*   with Grisu3: the double and the two halfway points to its neighbours are
+*   scaled by a cached power of ten into 64 bit fixed point numbers, and
+*   digits are generated until they're inside that interval. The scaling is
+*   slightly inexact, so for about half a percent of doubles it can't be sure
+*   the digits are the shortest or the closest ones, those are found by
+*   trying every precision with snprintf and strtod instead.
+*/
+
+// the longest text either function writes, "-2.2250738585072014e-308".
+#define MaxNumberLength     25
+
+// a 64 bit significand and a binary exponent, f * 2^e, which is exact unlike a double.
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+struct CachedPower {
+    uint64_t significand;
+    int16_t binaryExponent;
+    int16_t decimalExponent;
+};
+
+// 10^k for every 8th k from -348 to 340, normalized and rounded to 64 bits.
+static const struct CachedPower cachedPowers[] = {
+    { 0xfa8fd5a0081c0288ull, -1220, -348 },
+    { 0xbaaee17fa23ebf76ull, -1193, -340 },
+    { 0x8b16fb203055ac76ull, -1166, -332 },
+    { 0xcf42894a5dce35eaull, -1140, -324 },
+    { 0x9a6bb0aa55653b2dull, -1113, -316 },
+    { 0xe61acf033d1a45dfull, -1087, -308 },
+    { 0xab70fe17c79ac6caull, -1060, -300 },
+    { 0xff77b1fcbebcdc4full, -1034, -292 },
+    { 0xbe5691ef416bd60cull, -1007, -284 },
+    { 0x8dd01fad907ffc3cull, -980, -276 },
+    { 0xd3515c2831559a83ull, -954, -268 },
+    { 0x9d71ac8fada6c9b5ull, -927, -260 },
+    { 0xea9c227723ee8bcbull, -901, -252 },
+    { 0xaecc49914078536dull, -874, -244 },
+    { 0x823c12795db6ce57ull, -847, -236 },
+    { 0xc21094364dfb5637ull, -821, -228 },
+    { 0x9096ea6f3848984full, -794, -220 },
+    { 0xd77485cb25823ac7ull, -768, -212 },
+    { 0xa086cfcd97bf97f4ull, -741, -204 },
+    { 0xef340a98172aace5ull, -715, -196 },
+    { 0xb23867fb2a35b28eull, -688, -188 },
+    { 0x84c8d4dfd2c63f3bull, -661, -180 },
+    { 0xc5dd44271ad3cdbaull, -635, -172 },
+    { 0x936b9fcebb25c996ull, -608, -164 },
+    { 0xdbac6c247d62a584ull, -582, -156 },
+    { 0xa3ab66580d5fdaf6ull, -555, -148 },
+    { 0xf3e2f893dec3f126ull, -529, -140 },
+    { 0xb5b5ada8aaff80b8ull, -502, -132 },
+    { 0x87625f056c7c4a8bull, -475, -124 },
+    { 0xc9bcff6034c13053ull, -449, -116 },
+    { 0x964e858c91ba2655ull, -422, -108 },
+    { 0xdff9772470297ebdull, -396, -100 },
+    { 0xa6dfbd9fb8e5b88full, -369, -92 },
+    { 0xf8a95fcf88747d94ull, -343, -84 },
+    { 0xb94470938fa89bcfull, -316, -76 },
+    { 0x8a08f0f8bf0f156bull, -289, -68 },
+    { 0xcdb02555653131b6ull, -263, -60 },
+    { 0x993fe2c6d07b7facull, -236, -52 },
+    { 0xe45c10c42a2b3b06ull, -210, -44 },
+    { 0xaa242499697392d3ull, -183, -36 },
+    { 0xfd87b5f28300ca0eull, -157, -28 },
+    { 0xbce5086492111aebull, -130, -20 },
+    { 0x8cbccc096f5088ccull, -103, -12 },
+    { 0xd1b71758e219652cull, -77, -4 },
+    { 0x9c40000000000000ull, -50, 4 },
+    { 0xe8d4a51000000000ull, -24, 12 },
+    { 0xad78ebc5ac620000ull, 3, 20 },
+    { 0x813f3978f8940984ull, 30, 28 },
+    { 0xc097ce7bc90715b3ull, 56, 36 },
+    { 0x8f7e32ce7bea5c70ull, 83, 44 },
+    { 0xd5d238a4abe98068ull, 109, 52 },
+    { 0x9f4f2726179a2245ull, 136, 60 },
+    { 0xed63a231d4c4fb27ull, 162, 68 },
+    { 0xb0de65388cc8ada8ull, 189, 76 },
+    { 0x83c7088e1aab65dbull, 216, 84 },
+    { 0xc45d1df942711d9aull, 242, 92 },
+    { 0x924d692ca61be758ull, 269, 100 },
+    { 0xda01ee641a708deaull, 295, 108 },
+    { 0xa26da3999aef774aull, 322, 116 },
+    { 0xf209787bb47d6b85ull, 348, 124 },
+    { 0xb454e4a179dd1877ull, 375, 132 },
+    { 0x865b86925b9bc5c2ull, 402, 140 },
+    { 0xc83553c5c8965d3dull, 428, 148 },
+    { 0x952ab45cfa97a0b3ull, 455, 156 },
+    { 0xde469fbd99a05fe3ull, 481, 164 },
+    { 0xa59bc234db398c25ull, 508, 172 },
+    { 0xf6c69a72a3989f5cull, 534, 180 },
+    { 0xb7dcbf5354e9beceull, 561, 188 },
+    { 0x88fcf317f22241e2ull, 588, 196 },
+    { 0xcc20ce9bd35c78a5ull, 614, 204 },
+    { 0x98165af37b2153dfull, 641, 212 },
+    { 0xe2a0b5dc971f303aull, 667, 220 },
+    { 0xa8d9d1535ce3b396ull, 694, 228 },
+    { 0xfb9b7cd9a4a7443cull, 720, 236 },
+    { 0xbb764c4ca7a44410ull, 747, 244 },
+    { 0x8bab8eefb6409c1aull, 774, 252 },
+    { 0xd01fef10a657842cull, 800, 260 },
+    { 0x9b10a4e5e9913129ull, 827, 268 },
+    { 0xe7109bfba19c0c9dull, 853, 276 },
+    { 0xac2820d9623bf429ull, 880, 284 },
+    { 0x80444b5e7aa7cf85ull, 907, 292 },
+    { 0xbf21e44003acdd2dull, 933, 300 },
+    { 0x8e679c2f5e44ff8full, 960, 308 },
+    { 0xd433179d9c8cb841ull, 986, 316 },
+    { 0x9e19db92b4e31ba9ull, 1013, 324 },
+    { 0xeb96bf6ebadf77d9ull, 1039, 332 },
+    { 0xaf87023b9bf0ee6bull, 1066, 340 },
+};
+
+#define CachedPowersOffset          348
+#define CachedPowersDistance        8
+
+// the range scaled doubles are put in, so their integral part fits in 32 bits.
+#define MinimalTargetExponent       -60
+#define MaximalTargetExponent       -32
+
+#define SignificandBits             52
+#define HiddenBit                   ((uint64_t)1 << SignificandBits)
+#define ExponentBias                (0x3FF + SignificandBits)
+#define DenormalExponent            (1 - ExponentBias)
+
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+//@brief Copies the length characters of text into out like snprintf, cut to fit into size bytes.
+static size_t copyOut(char* out, size_t size, const char* text, size_t length)
+{
+    if (size > 0)
+    {
+        size_t copied = length < size ? length : size - 1;
+        memcpy(out, text, copied);
+        out[copied] = '\0';
+    }
+    return length;
+}
+
+//@brief Writes value's digits so they end right before end.
+//
+//@returns where they start.
+static char* writeDigits(char* end, uint64_t value)
+{
+    while (value >= 100)
+    {
+        end -= 2;
+        memcpy(end, &digitPairs[(value % 100) * 2], 2);
+        value /= 100;
+    }
+    if (value >= 10)
+    {
+        end -= 2;
+        memcpy(end, &digitPairs[value * 2], 2);
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+size_t mtIntToStringN(char* out, size_t size, int64_t value)
+{
+    char text[MaxNumberLength];
+    char* end = text + sizeof(text);
+
+    // the magnitude, INT64_MIN's doesn't fit in an int64_t.
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    char* start = writeDigits(end, magnitude);
+    if (value < 0)
+    {
+        *--start = '-';
+    }
+    return copyOut(out, size, start, (size_t)(end - start));
+}
+
+static struct DiyFp multiply(struct DiyFp a, struct DiyFp b)
+{
+    // the upper half of the product, rounded.
+    unsigned __int128 product = (unsigned __int128)a.f * b.f;
+    struct DiyFp out = { (uint64_t)(product >> 64) + (uint64_t)((product >> 63) & 1), a.e + b.e + 64 };
+    return out;
+}
+
+static struct DiyFp normalize(struct DiyFp value)
+{
+    int shift = __builtin_clzll(value.f);
+    value.f <<= shift;
+    value.e -= shift;
+    return value;
+}
+
+//@brief Finds the cached power c with MinimalTargetExponent <= e + c.e + 64 <= MaximalTargetExponent.
+static struct DiyFp getCachedPower(int e, int* decimalExponent)
+{
+    // ceil((MinimalTargetExponent - (e + 64) + 63) * log10(2)), the smallest k which can work.
+    int minimum = MinimalTargetExponent - (e + 64);
+    double k = (minimum + 63) * 0.30102999566398114;
+    int kInt = (int)k;
+    if (k > kInt)
+    {
+        kInt++;
+    }
+
+    int index = (CachedPowersOffset + kInt - 1) / CachedPowersDistance + 1;
+    const struct CachedPower* power = &cachedPowers[index];
+
+    *decimalExponent = power->decimalExponent;
+    struct DiyFp out = { power->significand, power->binaryExponent };
+    return out;
+}
+
+//@brief Finds the largest power of ten which isn't bigger than number.
+//
+//@param exponentPlusOne the number of digits number has, 0 for 0.
+static uint32_t biggestPowerOfTen(uint32_t number, int* exponentPlusOne)
+{
+    uint32_t power = 1000000000;
+    int exponent = 10;
+    while (power > number && exponent > 0)
+    {
+        power /= 10;
+        exponent--;
+    }
+    *exponentPlusOne = exponent;
+    return exponent > 0 ? power : 0;
+}
+
+//@brief Moves the last digit closer to w while it's still in the interval, see digitGen.
+//
+//@returns false if the digits might not be the closest ones.
+static bool roundWeed(char* buffer, int length, uint64_t distanceTooHighW, uint64_t unsafeInterval,
+                      uint64_t rest, uint64_t tenKappa, uint64_t unit)
+{
+    // w itself is only known to within one unit.
+    uint64_t smallDistance = distanceTooHighW - unit;
+    uint64_t bigDistance = distanceTooHighW + unit;
+
+    while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+           (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+    {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+
+    if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+        (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+    {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+//@brief Generates the fewest digits for w which are between low and high, all scaled.
+//
+//@param kappa set to the power of ten the last digit is at.
+//
+//@returns false if it can't be sure they're right.
+static bool digitGen(struct DiyFp low, struct DiyFp w, struct DiyFp high, char* buffer, int* length, int* kappa)
+{
+    // low and high are only known to within one unit, so only what's certainly between them counts.
+    uint64_t unit = 1;
+    struct DiyFp tooLow = { low.f - unit, low.e };
+    struct DiyFp tooHigh = { high.f + unit, high.e };
+    uint64_t unsafeInterval = tooHigh.f - tooLow.f;
+
+    // one is 1.0 at w's exponent, everything is split into its integral and fractional part.
+    int shift = -w.e;
+    uint64_t one = (uint64_t)1 << shift;
+    uint32_t integrals = (uint32_t)(tooHigh.f >> shift);
+    uint64_t fractionals = tooHigh.f & (one - 1);
+
+    int exponentPlusOne;
+    uint32_t divisor = biggestPowerOfTen(integrals, &exponentPlusOne);
+    *kappa = exponentPlusOne;
+    *length = 0;
+
+    while (*kappa > 0)
+    {
+        buffer[(*length)++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        (*kappa)--;
+
+        uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+        if (rest < unsafeInterval)
+        {
+            return roundWeed(buffer, *length, tooHigh.f - w.f, unsafeInterval, rest, 
+                             (uint64_t)divisor << shift, unit);
+        }
+        divisor /= 10;
+    }
+
+    while (true)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval *= 10;
+
+        buffer[(*length)++] = (char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        (*kappa)--;
+
+        if (fractionals < unsafeInterval)
+        {
+            return roundWeed(buffer, *length, (tooHigh.f - w.f) * unit, unsafeInterval, fractionals, one, unit);
+        }
+    }
+}
+
+//@brief Finds the shortest digits for value, which is finite and positive, with Grisu3.
+//
+//@param decimalExponent set so value is the digits times 10^decimalExponent.
+//
+//@returns false if they couldn't be found this way.
+static bool grisu3(double value, char* buffer, int* length, int* decimalExponent)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int biasedExponent = (int)((bits >> SignificandBits) & 0x7FF);
+    uint64_t significand = bits & (HiddenBit - 1);
+
+    struct DiyFp v;
+    if (biasedExponent != 0)
+    {
+        v.f = significand + HiddenBit;
+        v.e = biasedExponent - ExponentBias;
+    } else {
+        v.f = significand;
+        v.e = DenormalExponent;
+    }
+
+    // the halfway points to the neighbouring doubles, the one below is closer for powers of two.
+    struct DiyFp plus = normalize((struct DiyFp){ (v.f << 1) + 1, v.e - 1 });
+    struct DiyFp minus;
+    if (v.f == HiddenBit && biasedExponent > 1)
+    {
+        minus = (struct DiyFp){ (v.f << 2) - 1, v.e - 2 };
+    } else {
+        minus = (struct DiyFp){ (v.f << 1) - 1, v.e - 1 };
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    struct DiyFp w = normalize(v);
+
+    int cachedExponent;
+    struct DiyFp cachedPower = getCachedPower(w.e, &cachedExponent);
+
+    struct DiyFp scaledW = multiply(w, cachedPower);
+    struct DiyFp scaledMinus = multiply(minus, cachedPower);
+    struct DiyFp scaledPlus = multiply(plus, cachedPower);
+
+    int kappa;
+    if (!digitGen(scaledMinus, scaledW, scaledPlus, buffer, length, &kappa))
+    {
+        return false;
+    }
+
+    *decimalExponent = -cachedExponent + kappa;
+    return true;
+}
+
+//@brief Finds the shortest digits for value the slow way, with every precision in turn.
+static void shortestBySearch(double value, char* buffer, int* length, int* decimalExponent)
+{
+    char text[40];
+    for (int precision = 1; precision <= 17; precision++)
+    {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (strtod(text, NULL) == value || precision == 17)
+        {
+            break;
+        }
+    }
+
+    // d.ddde[+-]x
+    *length = 0;
+    char* position = text;
+    for (; *position != 'e'; position++)
+    {
+        if (*position != '.')
+        {
+            buffer[(*length)++] = *position;
+        }
+    }
+    int exponent = atoi(position + 1);
+
+    // trailing zeros don't count as digits.
+    while (*length > 1 && buffer[*length - 1] == '0')
+    {
+        (*length)--;
+    }
+    *decimalExponent = exponent - (*length - 1);
+}
+
+size_t mtDoubleToStringN(char* out, size_t size, double value)
+{
+    char text[MaxNumberLength + 8];
+    char* position = text;
+
+    if (value != value)
+    {
+        return copyOut(out, size, "nan", 3);
+    }
+
+    if (signbit(value))
+    {
+        *position++ = '-';
+        value = -value;
+    }
+
+    if (value == 0.0)
+    {
+        memcpy(position, "0.0", 3);
+        return copyOut(out, size, text, (size_t)(position + 3 - text));
+    }
+    if (value > DBL_MAX)
+    {
+        memcpy(position, "inf", 3);
+        return copyOut(out, size, text, (size_t)(position + 3 - text));
+    }
+
+    char digits[18];
+    int length;
+    int decimalExponent;
+    if (!grisu3(value, digits, &length, &decimalExponent))
+    {
+        shortestBySearch(value, digits, &length, &decimalExponent);
+    }
+
+    // the exponent of the first digit, scientific notation is used when that's far from the point.
+    int exponent = length + decimalExponent - 1;
+
+    if (exponent >= -4 && exponent < 16)
+    {
+        int point = exponent + 1;
+        if (point <= 0)
+        {
+            // 0.000ddd
+            memcpy(position, "0.", 2);
+            position += 2;
+            memset(position, '0', -point);
+            position += -point;
+            memcpy(position, digits, length);
+            position += length;
+        } 
+        else if (point >= length)
+        {
+            // ddd000.0, so it's still recognisable as a decimal.
+            memcpy(position, digits, length);
+            position += length;
+            memset(position, '0', point - length);
+            position += point - length;
+            memcpy(position, ".0", 2);
+            position += 2;
+        } else {
+            // ddd.ddd
+            memcpy(position, digits, point);
+            position += point;
+            *position++ = '.';
+            memcpy(position, digits + point, length - point);
+            position += length - point;
+        }
+    } else {
+        // d.ddde+xx, like printf's %e the exponent has at least two digits.
+        *position++ = digits[0];
+        if (length > 1)
+        {
+            *position++ = '.';
+            memcpy(position, digits + 1, length - 1);
+            position += length - 1;
+        }
+        *position++ = 'e';
+        *position++ = exponent < 0 ? '-' : '+';
+
+        int magnitude = exponent < 0 ? -exponent : exponent;
+        if (magnitude < 10)
+        {
+            *position++ = '0';
+        }
+        char exponentDigits[4];
+        char* end = exponentDigits + sizeof(exponentDigits);
+        char* start = writeDigits(end, (uint64_t)magnitude);
+        memcpy(position, start, end - start);
+        position += end - start;
+    }
+
+    return copyOut(out, size, text, (size_t)(position - text));
+}
@@ -0,0 +1,184 @@
+#include "mtOutput.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+
+#include "mtUtilities.h"
+
+#ifdef mtWin32
+    #include <io.h>
+    #define write _write
+    #define isatty _isatty
+#else
+    #include <unistd.h>
+#endif
+
+static char buffer[mtOutputBufferSize];
+static size_t used = 0;
+
+static struct mtOutputSink sink;
+static bool hasSink = false;
+
+static size_t writeFile(void* context, const char* data, size_t size)
+{
+    int fd = (int)(intptr_t)context;
+
+    size_t written = 0;
+    while (written < size)
+    {
+        long result = write(fd, data + written, size - written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            break;
+        }
+        written += result;
+    }
+    return written;
+}
+
+static size_t writeMemory(void* context, const char* data, size_t size)
+{
+    struct mtOutputMemory* memory = context;
+
+    if (memory->size + size + 1 > memory->capacity)
+    {
+        size_t capacity = memory->capacity ? memory->capacity : 256;
+        while (memory->size + size + 1 > capacity)
+        {
+            capacity *= 2;
+        }
+
+        char* data = realloc(memory->data, capacity);
+        if (data == NULL)
+        {
+            return 0;
+        }
+        memory->data = data;
+        memory->capacity = capacity;
+    }
+
+    memcpy(memory->data + memory->size, data, size);
+    memory->size += size;
+    memory->data[memory->size] = '\0';
+    return size;
+}
+
+//@brief Sets up the default sink the first time there's output, and flushes it at exit.
+static void initSink()
+{
+    if (hasSink)
+    {
+        return;
+    }
+
+    sink = mtOutputFileSink(1);
+    hasSink = true;
+    atexit(&mtOutputFlush);
+}
+
+struct mtOutputSink mtOutputFileSink(int fd)
+{
+    struct mtOutputSink out = { &writeFile, (void*)(intptr_t)fd, isatty(fd) != 0 };
+    return out;
+}
+
+struct mtOutputSink mtOutputMemorySink(struct mtOutputMemory* memory)
+{
+    struct mtOutputSink out = { &writeMemory, memory, false };
+    return out;
+}
+
+void mtOutputMemoryFree(struct mtOutputMemory* memory)
+{
+    free(memory->data);
+    memset(memory, 0, sizeof(struct mtOutputMemory));
+}
+
+void mtOutputSetSink(const struct mtOutputSink* newSink)
+{
+    initSink();
+    mtOutputFlush();
+
+    sink = newSink ? *newSink : mtOutputFileSink(1);
+}
+
+void mtOutputFlush()
+{
+    // if the sink can't take it there's nowhere else for it to go, so it's dropped either way.
+    if (used > 0)
+    {
+        sink.write(sink.context, buffer, used);
+        used = 0;
+    }
+}
+
+char* mtOutputReserve(size_t size)
+{
+    initSink();
+    if (size > mtOutputBufferSize - used)
+    {
+        mtOutputFlush();
+    }
+    return buffer + used;
+}
+
+void mtOutputCommit(size_t size)
+{
+    used += size;
+    if (sink.isInteractive && memchr(buffer + used - size, '\n', size))
+    {
+        mtOutputFlush();
+    }
+}
+
+void mtOutputWrite(const char* data, size_t size)
+{
+    if (size >= mtOutputBufferSize)
+    {
+        initSink();
+        mtOutputFlush();
+        sink.write(sink.context, data, size);
+        return;
+    }
+
+    memcpy(mtOutputReserve(size), data, size);
+    mtOutputCommit(size);
+}
+
+void mtOutputPrintf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    va_list copy;
+    va_copy(copy, args);
+
+    initSink();
+    size_t left = mtOutputBufferSize - used;
+    int length = vsnprintf(buffer + used, left, fmt, args);
+
+    if (length < 0)
+    {
+        // nothing was written, in a format it can't print.
+    } else if ((size_t)length < left) {
+        mtOutputCommit(length);
+    } else if ((size_t)length < mtOutputBufferSize) {
+        vsnprintf(mtOutputReserve(length + 1), length + 1, fmt, copy);
+        mtOutputCommit(length);
+    } else {
+        char* str = malloc(length + 1);
+        vsnprintf(str, length + 1, fmt, copy);
+        mtOutputWrite(str, length);
+        free(str);
+    }
+
+    va_end(copy);
+    va_end(args);
+}
@@ -0,0 +1,77 @@
+#include "mtPool.h"
+
+struct mtPoolBlock {
+    struct mtPoolBlock* next;
+};
+
+// one free list per size class, per thread, so no locking is needed.
+static _Thread_local struct mtPoolBlock* freeLists[mtPoolSizeClassCount];
+
+static int getSizeClass(size_t size)
+{
+    size_t blockSize = mtPoolMinBlockSize;
+    for (int i = 0; i < mtPoolSizeClassCount; i++)
+    {
+        if (size <= blockSize)
+            return i;
+        blockSize <<= 1;
+    }
+    return -1;
+}
+
+//@brief Carves a new chunk into blocks and puts them on the free list of sizeClass.
+static void refill(int sizeClass)
+{
+    size_t blockSize = (size_t)mtPoolMinBlockSize << sizeClass;
+    size_t blockCount = mtPoolChunkSize / blockSize;
+
+    // chunks are never given back to the system, the blocks are reused instead.
+    char* chunk = malloc(mtPoolChunkSize);
+    if (!chunk)
+        return;
+
+    for (size_t i = 0; i < blockCount; i++)
+    {
+        struct mtPoolBlock* block = (struct mtPoolBlock*)(chunk + i * blockSize);
+        block->next = freeLists[sizeClass];
+        freeLists[sizeClass] = block;
+    }
+}
+
+void* mtPoolAlloc(size_t size)
+{
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        return malloc(size);
+    }
+
+    if (!freeLists[sizeClass])
+    {
+        refill(sizeClass);
+        if (!freeLists[sizeClass])
+            return NULL;
+    }
+
+    struct mtPoolBlock* block = freeLists[sizeClass];
+    freeLists[sizeClass] = block->next;
+
+    return block;
+}
+
+void mtPoolFree(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    int sizeClass = getSizeClass(size);
+    if (sizeClass < 0)
+    {
+        free(ptr);
+        return;
+    }
+
+    struct mtPoolBlock* block = ptr;
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+}
@@ -1,30 +1,65 @@
 #include "mtUtilities.h"
 
-int mtStringToInt(int* out, char* str, int base)
+int mtStringToInt(int64_t* out, char* str, int base)
 {
-    //check for leading spaces
-    if (str[0] == '\0' || isspace(str[0]) || str == NULL)
+    if (str == NULL)
     {
         return mtStringToIntInconvertible;
     }
+    return mtStringToIntN(out, str, strlen(str), base);
+}
 
-    char* end = NULL;
-    long l = strtol(str, &end, base);
-
-    if (l > INT_MAX)
+int mtStringToIntN(int64_t* out, const char* str, size_t size, int base)
+{
+    //check for leading spaces
+    if (str == NULL || size == 0 || isspace(str[0]) || base < 2 || base > 36)
     {
-        return mtStringToIntOverflow;
+        return mtStringToIntInconvertible;
     }
-    if (l < INT_MIN)
+
+    size_t i = 0;
+    bool negative = str[0] == '-';
+    if (str[0] == '-' || str[0] == '+')
     {
-        return mtStringToIntUnderflow;
+        i++;
     }
-    if (*end != '\0')
+    if (i == size)
     {
         return mtStringToIntInconvertible;
     }
 
-    *out = l;
+    // the magnitude, INT64_MIN's doesn't fit in an int64_t.
+    uint64_t magnitude = 0;
+    bool overflowed = false;
+    for (; i < size; i++)
+    {
+        char c = tolower(str[i]);
+        int digit = isdigit(c) ? c - '0' : (c >= 'a' && c <= 'z') ? c - 'a' + 10 : base;
+        if (digit >= base)
+        {
+            return mtStringToIntInconvertible;
+        }
+
+        overflowed = overflowed || 
+                     __builtin_mul_overflow(magnitude, (uint64_t)base, &magnitude) ||
+                     __builtin_add_overflow(magnitude, (uint64_t)digit, &magnitude);
+    }
+
+    if (negative)
+    {
+        if (overflowed || magnitude > (uint64_t)INT64_MAX + 1)
+        {
+            return mtStringToIntUnderflow;
+        }
+        *out = (int64_t)(0 - magnitude);
+        return mtSuccess;
+    }
+
+    if (overflowed || magnitude > INT64_MAX)
+    {
+        return mtStringToIntOverflow;
+    }
+    *out = (int64_t)magnitude;
     return mtSuccess;
 }
 